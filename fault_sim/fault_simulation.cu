@@ -6,8 +6,8 @@
 #include "CycleTimer.h"
 #include "fframe.h"
 
-// Data structure memory limits
-#define LIMIT_NUM_SIGNALS 8192
+// Device memory for the per-thread circuit states, test vectors are launched in batches that fit
+#define STATE_MEMORY_BUDGET (512 * 1024 * 1024)
 
 // CUDA error checking
 #define DEBUG
@@ -38,14 +38,18 @@ __constant__ GlobalConstants cuConstParams;
 
 // Parallel implementation of fault simulation provided the CUDA-friendly input and output data structures
 __global__ void
-faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder, int* aCudaCircuitInputs,  int* aCudaCircuitOutputs,  uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitConnections, int* aCudaCircuitTraversalOrder, int* aCudaCircuitInputs,  int* aCudaCircuitOutputs,  uint8_t* aTestVectors, uint8_t* aDetectedFaults, uint8_t* aCudaCircuitStates, uint8_t* aCudaCorrectOutputs, int aFirstTestVectorIdx) {
 
-    int myTestVectorIdx = blockIdx.x;
+    int myTestVectorIdx = aFirstTestVectorIdx + blockIdx.x;
     int myThreadIdx = threadIdx.x;
 
-    // Initialize shared golden outputs array and circuit state array
-    __shared__ uint8_t myCorrectOutputs[LIMIT_NUM_SIGNALS];
-    uint8_t myLocalCircuitState[LIMIT_NUM_SIGNALS];
+    // Golden outputs in shared memory sized at launch, or in the global fallback buffer when they do not fit
+    extern __shared__ uint8_t mySharedCorrectOutputs[];
+    uint8_t* myCorrectOutputs = aCudaCorrectOutputs ? aCudaCorrectOutputs + static_cast<std::size_t>(blockIdx.x) * cuConstParams.numCircuitOutputs : mySharedCorrectOutputs;
+    // Circuit state array in global memory interleaved across the threads of the launch so neighbouring threads
+    // access neighbouring bytes, signal offsets are computed in std::size_t
+    const std::size_t myStateStride = static_cast<std::size_t>(gridDim.x) * blockDim.x;
+    uint8_t* myLocalCircuitState = aCudaCircuitStates + blockIdx.x * blockDim.x + myThreadIdx;
 
     // Thread iterates through all responsible faults
     for (int myFaultIdx = myThreadIdx; myFaultIdx < (cuConstParams.numCircuitSignals * 2) + 1; myFaultIdx += blockDim.x) {
@@ -54,18 +58,18 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
 
         // Traverse through the inputs of the circuit to populate the state
         for (myCurrTraversalIdx = 0; myCurrTraversalIdx < cuConstParams.numCircuitInputs; myCurrTraversalIdx++) {
-            uint8_t myNewCircuitVal = aTestVectors[myTestVectorIdx*cuConstParams.numCircuitInputs + myCurrTraversalIdx];
+            uint8_t myNewCircuitVal = aTestVectors[static_cast<std::size_t>(myTestVectorIdx)*cuConstParams.numCircuitInputs + myCurrTraversalIdx];
 
             // Override state if the signal corresponds to the current faultIdx
             if ((myFaultIdx != 0) && ((myFaultIdx-1) / 2) == aCudaCircuitTraversalOrder[myCurrTraversalIdx]){
                 if ((myFaultIdx-1) % 2 == 0) {
-                    myLocalCircuitState[aCudaCircuitTraversalOrder[myCurrTraversalIdx]] = 0;
+                    myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitTraversalOrder[myCurrTraversalIdx]) * myStateStride] = 0;
                 } else {
-                    myLocalCircuitState[aCudaCircuitTraversalOrder[myCurrTraversalIdx]] = 1;
+                    myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitTraversalOrder[myCurrTraversalIdx]) * myStateStride] = 1;
                 }
             } else {
                 // Write correct circuit value
-                myLocalCircuitState[aCudaCircuitTraversalOrder[myCurrTraversalIdx]] = myNewCircuitVal;
+                myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitTraversalOrder[myCurrTraversalIdx]) * myStateStride] = myNewCircuitVal;
             }
         }
 
@@ -74,7 +78,7 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
 
             int myCurrentGateIdx = aCudaCircuitTraversalOrder[myCurrTraversalIdx];
             CudaGate myCurrGate = aCudaCircuitStructure[myCurrentGateIdx];
-            uint8_t myNewCircuitVal = myLocalCircuitState[myCurrGate.fanin[0]];
+            uint8_t myNewCircuitVal = myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset]) * myStateStride];
 
             // Update circuit signal state based on signal type
             switch (myCurrGate.gateType)
@@ -82,37 +86,37 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
             // Determine output value given all current inputs (guaranteed to be determinable due to predetermined traversal order)
             case CudaGateType::AND:
                 for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                    myNewCircuitVal &= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                    myNewCircuitVal &= myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset + myInputIdx]) * myStateStride];
                 }
                 break;
             case CudaGateType::OR:
                 for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                    myNewCircuitVal |= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                    myNewCircuitVal |= myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset + myInputIdx]) * myStateStride];
                 }
                 break;
             case CudaGateType::NOT:
-                myNewCircuitVal = !myCurrGate.fanin[0];
+                myNewCircuitVal = !myNewCircuitVal;
                 break;
             case CudaGateType::XOR:
                 for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                    myNewCircuitVal ^= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                    myNewCircuitVal ^= myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset + myInputIdx]) * myStateStride];
                 }
                 break;
             case CudaGateType::NAND:
                 for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                    myNewCircuitVal &= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                    myNewCircuitVal &= myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset + myInputIdx]) * myStateStride];
                 }
                 myNewCircuitVal = !myNewCircuitVal;
                 break;
             case CudaGateType::NOR:
                 for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                    myNewCircuitVal |= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                    myNewCircuitVal |= myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset + myInputIdx]) * myStateStride];
                 }
                 myNewCircuitVal = !myNewCircuitVal;
                 break;
             case CudaGateType::XNOR:
                 for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                    myNewCircuitVal ^= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                    myNewCircuitVal ^= myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitConnections[myCurrGate.faninOffset + myInputIdx]) * myStateStride];
                 }
                 myNewCircuitVal = !myNewCircuitVal;
                 break;
@@ -130,13 +134,13 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
             // Override state if the signal corresponds to the current faultIdx
             if ((myFaultIdx != 0) && ((myFaultIdx-1) / 2) == aCudaCircuitTraversalOrder[myCurrTraversalIdx]){
                 if ((myFaultIdx-1) % 2 == 0) {
-                    myLocalCircuitState[aCudaCircuitTraversalOrder[myCurrTraversalIdx]] = 0;
+                    myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitTraversalOrder[myCurrTraversalIdx]) * myStateStride] = 0;
                 } else {
-                    myLocalCircuitState[aCudaCircuitTraversalOrder[myCurrTraversalIdx]] = 1;
+                    myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitTraversalOrder[myCurrTraversalIdx]) * myStateStride] = 1;
                 }
             } else {
                 // Write correct circuit value
-                myLocalCircuitState[aCudaCircuitTraversalOrder[myCurrTraversalIdx]] = myNewCircuitVal;
+                myLocalCircuitState[static_cast<std::size_t>(aCudaCircuitTraversalOrder[myCurrTraversalIdx]) * myStateStride] = myNewCircuitVal;
             }
         }
 
@@ -145,7 +149,7 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
             for (int i = 0; i < cuConstParams.numCircuitOutputs; i++) {
 
                 int myOutputIdx = aCudaCircuitOutputs[i];
-                myCorrectOutputs[i] = myLocalCircuitState[myOutputIdx];
+                myCorrectOutputs[i] = myLocalCircuitState[static_cast<std::size_t>(myOutputIdx) * myStateStride];
             }
         }
 
@@ -153,12 +157,12 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
 
         // All other faultIdx/threadIdx compare local output states against shared golden states and populates global detection data structure
         if (myFaultIdx != 0){
-            int myDetectedFaultsIdx = myTestVectorIdx * (cuConstParams.numCircuitSignals * 2) + myFaultIdx - 1;
+            std::size_t myDetectedFaultsIdx = static_cast<std::size_t>(myTestVectorIdx) * (cuConstParams.numCircuitSignals * 2) + myFaultIdx - 1;
             aDetectedFaults[myDetectedFaultsIdx] = 0;
             for (int i = 0; i < cuConstParams.numCircuitOutputs; i++) {
 
                 int myOutputIdx = aCudaCircuitOutputs[i];
-                if (myCorrectOutputs[i] != myLocalCircuitState[myOutputIdx]) {
+                if (myCorrectOutputs[i] != myLocalCircuitState[static_cast<std::size_t>(myOutputIdx) * myStateStride]) {
                     aDetectedFaults[myDetectedFaultsIdx] = 1;
                 }
 
@@ -169,24 +173,37 @@ faultSim_kernel(CudaGate* aCudaCircuitStructure, int* aCudaCircuitTraversalOrder
 
 
 // CUDA entry point - initialize memory and invoke kernel
-void cudaFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+void cudaFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
 
-    // Compute number of blocks and threads per block
+    // Compute threads per block and how many test vectors (blocks) each launch can hold state for
     const int myThreadsPerBlock = std::min((aNumCircuitSignals * 2) + 1, 768);
-    const int myNumBlocks = aNumTestVectors;
-
-    if (aNumCircuitSignals >= LIMIT_NUM_SIGNALS){
-        printf("Error: Too many signals within circuit - need to increase LIMIT_NUM_SIGNALS\n");
-    }
+    const std::size_t myStateBytesPerBlock = static_cast<std::size_t>(myThreadsPerBlock) * aNumCircuitSignals;
+    const int myBlocksPerLaunch = std::max(1, static_cast<int>(std::min<std::size_t>(aNumTestVectors, STATE_MEMORY_BUDGET / myStateBytesPerBlock)));
+    // Golden outputs go in dynamic shared memory unless they exceed the per-block limit of the device
+    int myDevice;
+    int myMaxSharedBytes;
+    cudaCheckError(cudaGetDevice(&myDevice));
+    cudaCheckError(cudaDeviceGetAttribute(&myMaxSharedBytes, cudaDevAttrMaxSharedMemoryPerBlock, myDevice));
+    const bool mySharedOutputs = aNumCircuitOutputs <= myMaxSharedBytes;
+    // The connection array ends with the fanouts of the last gate
+    const int myNumConnections = aCircuitStructure[aNumCircuitSignals - 1].fanoutOffset + aCircuitStructure[aNumCircuitSignals - 1].fanoutSize;
 
     // Allocate buffers on GPU
     CudaGate* myCudaCircuitStructure;
+    int* myCudaCircuitConnections;
+    uint8_t* myCudaCircuitStates;
+    uint8_t* myCudaCorrectOutputs = nullptr;
     int* myCudaCircuitTraversalOrder;
     int* myCudaCircuitInputs;
     int* myCudaCircuitOutputs;
     uint8_t* myCudaTestVectors;
     uint8_t* myCudaDetectedFaults;
     cudaMalloc(&myCudaCircuitStructure, sizeof(CudaGate) * aNumCircuitSignals);
+    cudaMalloc(&myCudaCircuitConnections, sizeof(int) * myNumConnections);
+    cudaMalloc(&myCudaCircuitStates, myStateBytesPerBlock * myBlocksPerLaunch);
+    if (!mySharedOutputs) {
+        cudaMalloc(&myCudaCorrectOutputs, static_cast<std::size_t>(aNumCircuitOutputs) * myBlocksPerLaunch);
+    }
     cudaMalloc(&myCudaCircuitTraversalOrder, sizeof(int) * aNumCircuitSignals);
     cudaMalloc(&myCudaCircuitInputs, sizeof(int) * aNumCircuitInputs);
     cudaMalloc(&myCudaCircuitOutputs, sizeof(int) * aNumCircuitOutputs);
@@ -195,6 +212,7 @@ void cudaFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCir
 
     // Perform memcpy of data structures
     cudaMemcpy(myCudaCircuitStructure, aCircuitStructure, sizeof(CudaGate) * aNumCircuitSignals, cudaMemcpyHostToDevice);
+    cudaMemcpy(myCudaCircuitConnections, aCircuitConnections, sizeof(int) * myNumConnections, cudaMemcpyHostToDevice);
     cudaMemcpy(myCudaCircuitTraversalOrder, aCircuitTraversalOrder, sizeof(int) * aNumCircuitSignals, cudaMemcpyHostToDevice);
     cudaMemcpy(myCudaCircuitInputs, aCircuitInputs, sizeof(int) * aNumCircuitInputs, cudaMemcpyHostToDevice);
     cudaMemcpy(myCudaCircuitOutputs, aCircuitOutputs, sizeof(int) * aNumCircuitOutputs, cudaMemcpyHostToDevice);
@@ -208,9 +226,14 @@ void cudaFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCir
     params.numTestVectors = aNumTestVectors;
     cudaMemcpyToSymbol(cuConstParams, &params, sizeof(GlobalConstants));
 
-    // Run kernel
-    faultSim_kernel<<<myNumBlocks, myThreadsPerBlock>>>(myCudaCircuitStructure, myCudaCircuitTraversalOrder, myCudaCircuitInputs, myCudaCircuitOutputs, myCudaTestVectors, myCudaDetectedFaults);
-    cudaCheckError(cudaDeviceSynchronize());
+    // Run kernel, one block per test vector and as many blocks per launch as the state memory allows
+    for (int myFirstTestVectorIdx = 0; myFirstTestVectorIdx < aNumTestVectors; myFirstTestVectorIdx += myBlocksPerLaunch) {
+        const int myNumBlocks = std::min(myBlocksPerLaunch, aNumTestVectors - myFirstTestVectorIdx);
+        faultSim_kernel<<<myNumBlocks, myThreadsPerBlock, mySharedOutputs ? aNumCircuitOutputs : 0>>>(myCudaCircuitStructure, myCudaCircuitConnections, myCudaCircuitTraversalOrder, myCudaCircuitInputs, myCudaCircuitOutputs, myCudaTestVectors, myCudaDetectedFaults, myCudaCircuitStates, myCudaCorrectOutputs, myFirstTestVectorIdx);
+        cudaCheckError(cudaDeviceSynchronize());
+    }
+    cudaFree(myCudaCircuitStates);
+    cudaFree(myCudaCorrectOutputs);
 
     // Perform memcpy of results
     cudaMemcpy(aDetectedFaults, myCudaDetectedFaults, sizeof(uint8_t) * aNumCircuitSignals * 2 * aNumTestVectors, cudaMemcpyDeviceToHost);
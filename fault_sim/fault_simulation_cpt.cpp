@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "fframe.h"
+#include "fsim.h"
+
+// Whether flipping the good value of input aSignal flips the output of aGate
+static inline bool isSensitive(const CudaGate& aGate, const int* aCircuitConnections, const uint8_t* aCircuitState, int aSignal) {
+    uint8_t myControllingVal;
+
+    switch (aGate.gateType)
+    {
+    case CudaGateType::AND:
+    case CudaGateType::NAND:
+        myControllingVal = 0;
+        break;
+    case CudaGateType::OR:
+    case CudaGateType::NOR:
+        myControllingVal = 1;
+        break;
+    case CudaGateType::XOR:
+    case CudaGateType::XNOR:
+    case CudaGateType::NOT:
+    case CudaGateType::BUFF:
+        return true;
+    default:
+        return false;
+    }
+
+    // Sensitive if no other input holds the controlling value
+    for (int myInputIdx = 0; myInputIdx < aGate.faninSize; myInputIdx++) {
+        if (aCircuitConnections[aGate.faninOffset + myInputIdx] != aSignal && aCircuitState[aCircuitConnections[aGate.faninOffset + myInputIdx]] == myControllingVal) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Critical path tracing over fanout-free regions
+// A fanout-free region is the tree of signals with a single fanout that feeds one stem (a signal with several or no
+// fanouts, or an output). Inside it a line is critical when its gate output is critical and the line is sensitive,
+// which is traced backward from the stem; only the stems are flipped and simulated explicitly to see if they reach an
+// output. A fault is then detected exactly when it is activated, its line is critical and the stem of its region is.
+void
+faultSim_cpt(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+
+    const int myNumFaults = aNumCircuitSignals * 2;
+
+    std::vector<uint8_t> myIsOutput(aNumCircuitSignals, 0);
+    for (int i = 0; i < aNumCircuitOutputs; i++) {
+        myIsOutput[aCircuitOutputs[i]] = 1;
+    }
+
+    // Stem of the fanout-free region of every signal, found backward along the single fanouts
+    std::vector<int> myStems(aNumCircuitSignals);
+    std::vector<int> myStemSignals = std::vector<int>();
+    for (int myCurrTraversalIdx = aNumCircuitSignals - 1; myCurrTraversalIdx >= 0; myCurrTraversalIdx--) {
+        int mySignal = aCircuitTraversalOrder[myCurrTraversalIdx];
+        if (aCircuitStructure[mySignal].fanoutSize != 1 || myIsOutput[mySignal]) {
+            myStems[mySignal] = mySignal;
+            myStemSignals.push_back(mySignal);
+        } else {
+            myStems[mySignal] = myStems[aCircuitConnections[aCircuitStructure[mySignal].fanoutOffset]];
+        }
+    }
+
+    const CudaNetlist myNetlist = {aCircuitStructure, aCircuitConnections};
+
+    std::vector<uint8_t> myGoodCircuitState(aNumCircuitSignals);
+    std::vector<uint8_t> myFaultyCircuitState(aNumCircuitSignals);
+    std::vector<uint8_t> myCritical(aNumCircuitSignals);
+    std::vector<uint8_t> myStemDetected(aNumCircuitSignals);
+    EventPropagator<uint8_t> myPropagator(aNumCircuitSignals, myNetlist.getMaxLevel(aNumCircuitSignals));
+    long myNumEvaluations = 0;
+
+    for (int myTestVectorIdx = 0; myTestVectorIdx < aNumTestVectors; myTestVectorIdx++) {
+
+        for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitInputs; myCurrTraversalIdx++) {
+            myGoodCircuitState[aCircuitTraversalOrder[myCurrTraversalIdx]] = aTestVectors[static_cast<std::size_t>(myTestVectorIdx) * aNumCircuitInputs + myCurrTraversalIdx];
+        }
+        for (int myCurrTraversalIdx = aNumCircuitInputs; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+            int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+            myGoodCircuitState[myCurrentGateIdx] = evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myGoodCircuitState.data(), myCurrentGateIdx);
+        }
+        myNumEvaluations += aNumCircuitSignals - aNumCircuitInputs;
+        myFaultyCircuitState = myGoodCircuitState;
+
+        // Trace the critical lines backward inside each fanout-free region
+        for (int myCurrTraversalIdx = aNumCircuitSignals - 1; myCurrTraversalIdx >= 0; myCurrTraversalIdx--) {
+            int mySignal = aCircuitTraversalOrder[myCurrTraversalIdx];
+            if (myStems[mySignal] == mySignal) {
+                myCritical[mySignal] = 1;
+            } else {
+                int myFanout = aCircuitConnections[aCircuitStructure[mySignal].fanoutOffset];
+                myCritical[mySignal] = myCritical[myFanout] && isSensitive(aCircuitStructure[myFanout], aCircuitConnections, myGoodCircuitState.data(), mySignal);
+            }
+        }
+
+        // Flip every stem and simulate its cone event-driven until the difference reaches an output or dies out
+        for (int myStem : myStemSignals) {
+            bool myDetected = false;
+
+            myPropagator.propagate(myNetlist, myFaultyCircuitState, myStem, static_cast<uint8_t>(!myGoodCircuitState[myStem]),
+                [&](int aGate, const std::vector<uint8_t>& aState) { return evaluateGate(aCircuitStructure[aGate], aCircuitConnections, aState.data(), aGate); },
+                [&](int aSignal, uint8_t) { myDetected |= (myIsOutput[aSignal] != 0); },
+                [&]() { return myDetected; });
+            myPropagator.restore(myFaultyCircuitState, myGoodCircuitState.data());
+
+            myStemDetected[myStem] = myDetected;
+        }
+
+        // A fault is detected when activated on a critical line whose stem is detected
+        for (int myFaultIdx = 0; myFaultIdx < myNumFaults; myFaultIdx++) {
+            const int myFaultSignal = myFaultIdx / 2;
+            const uint8_t myStuckValue = myFaultIdx % 2;
+            aDetectedFaults[static_cast<std::size_t>(myTestVectorIdx) * myNumFaults + myFaultIdx] = (myGoodCircuitState[myFaultSignal] != myStuckValue) && myCritical[myFaultSignal] && myStemDetected[myStems[myFaultSignal]];
+        }
+    }
+
+    myNumEvaluations += myPropagator.theNumEvaluations;
+    std::cout << "Critical path tracing: " << myStemSignals.size() << " of " << aNumCircuitSignals << " signals are stems simulated explicitly"
+              << " | Gate evaluations per vector: " << (aNumTestVectors > 0 ? static_cast<double>(myNumEvaluations) / aNumTestVectors : 0.0) << std::endl;
+}
+
+
+void cptFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_cpt(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+}
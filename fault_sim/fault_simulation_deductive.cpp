@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "fframe.h"
+
+// Sorted set operations on fault lists
+static const auto setUnion = [](auto... anArgs) { return std::set_union(anArgs...); };
+static const auto setIntersection = [](auto... anArgs) { return std::set_intersection(anArgs...); };
+static const auto setDifference = [](auto... anArgs) { return std::set_difference(anArgs...); };
+static const auto setSymmetricDifference = [](auto... anArgs) { return std::set_symmetric_difference(anArgs...); };
+
+// Replace aSet by its union, intersection, difference or symmetric difference with anOther (both sorted)
+template <typename SetOperation>
+static inline void applySetOperation(std::vector<int>& aSet, const std::vector<int>& anOther, std::vector<int>& aScratch, SetOperation anOperation) {
+    aScratch.clear();
+    anOperation(aSet.begin(), aSet.end(), anOther.begin(), anOther.end(), std::back_inserter(aScratch));
+    aSet.swap(aScratch);
+}
+
+
+// Deductive fault simulation
+// Every signal carries the sorted list of faults that flip it under the current test vector, deduced from the lists of
+// its fanins in traversal order; the faults listed at the outputs are the detected ones. A list is released once all
+// fanouts of its signal have used it, so only the lists on the current frontier are kept alive.
+void
+faultSim_deductive(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+
+    const int myNumFaults = aNumCircuitSignals * 2;
+
+    std::vector<uint8_t> myIsOutput(aNumCircuitSignals, 0);
+    for (int i = 0; i < aNumCircuitOutputs; i++) {
+        myIsOutput[aCircuitOutputs[i]] = 1;
+    }
+
+    std::vector<uint8_t> myCircuitState(aNumCircuitSignals);
+    std::vector<std::vector<int>> myFaultLists(aNumCircuitSignals);
+    std::vector<int> myRemainingFanouts(aNumCircuitSignals);
+    std::vector<int> mySideList = std::vector<int>();
+    std::vector<int> myScratch = std::vector<int>();
+
+    std::size_t myPeakListEntries = 0;
+    double myMaxVectorTime = 0;
+    auto myStart = std::chrono::high_resolution_clock::now();
+
+    for (int myTestVectorIdx = 0; myTestVectorIdx < aNumTestVectors; myTestVectorIdx++) {
+        auto myVectorStart = std::chrono::high_resolution_clock::now();
+        uint8_t* myDetected = aDetectedFaults + static_cast<std::size_t>(myTestVectorIdx) * myNumFaults;
+        std::fill(myDetected, myDetected + myNumFaults, 0);
+        std::size_t myLiveListEntries = 0;
+
+        for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+            const int mySignal = aCircuitTraversalOrder[myCurrTraversalIdx];
+            const CudaGate& myGate = aCircuitStructure[mySignal];
+            std::vector<int>& myList = myFaultLists[mySignal];
+            myList.clear();
+
+            if (myCurrTraversalIdx < aNumCircuitInputs) {
+                myCircuitState[mySignal] = aTestVectors[static_cast<std::size_t>(myTestVectorIdx) * aNumCircuitInputs + myCurrTraversalIdx];
+            } else {
+                myCircuitState[mySignal] = evaluateGate(myGate, aCircuitConnections, myCircuitState.data(), mySignal);
+
+                int myControllingVal = -1;
+                switch (myGate.gateType)
+                {
+                case CudaGateType::AND:
+                case CudaGateType::NAND:
+                    myControllingVal = 0;
+                    break;
+                case CudaGateType::OR:
+                case CudaGateType::NOR:
+                    myControllingVal = 1;
+                    break;
+                default:
+                    break;
+                }
+
+                if (myControllingVal < 0) {
+                    // XOR/XNOR flip with an odd number of flipped inputs, NOT/BUFF with their only one
+                    for (int myInputIdx = 0; myInputIdx < myGate.faninSize; myInputIdx++) {
+                        applySetOperation(myList, myFaultLists[aCircuitConnections[myGate.faninOffset + myInputIdx]], myScratch, setSymmetricDifference);
+                    }
+                } else {
+                    // With no input at the controlling value any flipped input flips the gate; otherwise a fault has
+                    // to flip every controlling input and none of the others
+                    bool myHasControlling = false;
+                    for (int myInputIdx = 0; myInputIdx < myGate.faninSize; myInputIdx++) {
+                        myHasControlling |= (myCircuitState[aCircuitConnections[myGate.faninOffset + myInputIdx]] == myControllingVal);
+                    }
+
+                    if (!myHasControlling) {
+                        for (int myInputIdx = 0; myInputIdx < myGate.faninSize; myInputIdx++) {
+                            applySetOperation(myList, myFaultLists[aCircuitConnections[myGate.faninOffset + myInputIdx]], myScratch, setUnion);
+                        }
+                    } else {
+                        bool myIsFirst = true;
+                        mySideList.clear();
+                        for (int myInputIdx = 0; myInputIdx < myGate.faninSize; myInputIdx++) {
+                            const std::vector<int>& myInputList = myFaultLists[aCircuitConnections[myGate.faninOffset + myInputIdx]];
+                            if (myCircuitState[aCircuitConnections[myGate.faninOffset + myInputIdx]] == myControllingVal) {
+                                if (myIsFirst) {
+                                    myList = myInputList;
+                                    myIsFirst = false;
+                                } else {
+                                    applySetOperation(myList, myInputList, myScratch, setIntersection);
+                                }
+                            } else {
+                                applySetOperation(mySideList, myInputList, myScratch, setUnion);
+                            }
+                        }
+                        applySetOperation(myList, mySideList, myScratch, setDifference);
+                    }
+                }
+
+                // Release the fanin lists no later gate needs
+                for (int myInputIdx = 0; myInputIdx < myGate.faninSize; myInputIdx++) {
+                    int myFanin = aCircuitConnections[myGate.faninOffset + myInputIdx];
+                    if (--myRemainingFanouts[myFanin] == 0) {
+                        myLiveListEntries -= myFaultLists[myFanin].size();
+                        std::vector<int>().swap(myFaultLists[myFanin]);
+                    }
+                }
+            }
+
+            // The stuck-at fault opposite to the good value flips the signal itself
+            const int myLocalFault = 2 * mySignal + !myCircuitState[mySignal];
+            myList.insert(std::lower_bound(myList.begin(), myList.end(), myLocalFault), myLocalFault);
+
+            if (myIsOutput[mySignal]) {
+                for (int myFaultIdx : myList) {
+                    myDetected[myFaultIdx] = 1;
+                }
+            }
+
+            myRemainingFanouts[mySignal] = myGate.fanoutSize;
+            if (myGate.fanoutSize == 0) {
+                std::vector<int>().swap(myList);
+            } else {
+                myLiveListEntries += myList.size();
+                myPeakListEntries = std::max(myPeakListEntries, myLiveListEntries);
+            }
+        }
+
+        double myVectorTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - myVectorStart).count();
+        myMaxVectorTime = std::max(myMaxVectorTime, myVectorTime);
+        #ifdef DEBUG
+        std::cout << "Debug: Vector " << myTestVectorIdx << " deduced in " << myVectorTime << " s" << std::endl;
+        #endif
+    }
+
+    double myTotalTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - myStart).count();
+    std::cout << "Deductive fault lists: peak " << myPeakListEntries << " entries (" << (myPeakListEntries * sizeof(int)) / 1024.0 << " KB)"
+              << " | Time per vector (s): " << (aNumTestVectors > 0 ? myTotalTime / aNumTestVectors : 0.0) << " avg, " << myMaxVectorTime << " max" << std::endl;
+}
+
+
+void deductiveFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_deductive(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+}
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "fframe.h"
+#include "fsim.h"
+
+// Gate evaluations of every fault in the last event-driven run, summed over its test vectors (fault index order)
+std::vector<long> theEventFaultEvaluations;
+
+
+// Event-driven fault simulation restricted to the fanout cone of each fault
+// The good machine is simulated once per test vector and kept; a fault then only evaluates the gates with an input
+// that differs from the good machine, level by level, and stops as soon as a difference reaches an output or none is
+// left. Gate evaluations are counted per fault so they can be compared with re-simulating the whole circuit.
+void
+faultSim_event(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+
+    const int myNumFaults = aNumCircuitSignals * 2;
+    const int myNumGates = aNumCircuitSignals - aNumCircuitInputs;
+
+    const CudaNetlist myNetlist = {aCircuitStructure, aCircuitConnections};
+
+    std::vector<uint8_t> myIsOutput(aNumCircuitSignals, 0);
+    for (int i = 0; i < aNumCircuitOutputs; i++) {
+        myIsOutput[aCircuitOutputs[i]] = 1;
+    }
+
+    std::vector<uint8_t> myGoodCircuitState(aNumCircuitSignals);
+    std::vector<uint8_t> myFaultyCircuitState(aNumCircuitSignals);
+    EventPropagator<uint8_t> myPropagator(aNumCircuitSignals, myNetlist.getMaxLevel(aNumCircuitSignals));
+    std::vector<long> myFaultEvaluations(myNumFaults, 0);
+
+    for (int myTestVectorIdx = 0; myTestVectorIdx < aNumTestVectors; myTestVectorIdx++) {
+
+        for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitInputs; myCurrTraversalIdx++) {
+            myGoodCircuitState[aCircuitTraversalOrder[myCurrTraversalIdx]] = aTestVectors[static_cast<std::size_t>(myTestVectorIdx) * aNumCircuitInputs + myCurrTraversalIdx];
+        }
+        for (int myCurrTraversalIdx = aNumCircuitInputs; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+            int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+            myGoodCircuitState[myCurrentGateIdx] = evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myGoodCircuitState.data(), myCurrentGateIdx);
+        }
+        myFaultyCircuitState = myGoodCircuitState;
+
+        for (int myFaultIdx = 0; myFaultIdx < myNumFaults; myFaultIdx++) {
+            const int myFaultSignal = myFaultIdx / 2;
+            const uint8_t myStuckValue = myFaultIdx % 2;
+            bool myDetected = false;
+
+            // An unactivated fault changes nothing
+            if (myGoodCircuitState[myFaultSignal] != myStuckValue) {
+                const long myPrevEvaluations = myPropagator.theNumEvaluations;
+                myPropagator.propagate(myNetlist, myFaultyCircuitState, myFaultSignal, myStuckValue,
+                    [&](int aGate, const std::vector<uint8_t>& aState) { return evaluateGate(aCircuitStructure[aGate], aCircuitConnections, aState.data(), aGate); },
+                    [&](int aSignal, uint8_t) { myDetected |= (myIsOutput[aSignal] != 0); },
+                    [&]() { return myDetected; });
+                myFaultEvaluations[myFaultIdx] += myPropagator.theNumEvaluations - myPrevEvaluations;
+
+                // Restore the good machine for the next fault
+                myPropagator.restore(myFaultyCircuitState, myGoodCircuitState.data());
+            }
+
+            aDetectedFaults[static_cast<std::size_t>(myTestVectorIdx) * myNumFaults + myFaultIdx] = myDetected;
+        }
+    }
+
+    // Evaluation counts against re-simulating every gate for every fault and vector
+    long myTotalEvaluations = 0;
+    long myMaxEvaluations = 0;
+    for (int myFaultIdx = 0; myFaultIdx < myNumFaults; myFaultIdx++) {
+        myTotalEvaluations += myFaultEvaluations[myFaultIdx];
+        myMaxEvaluations = std::max(myMaxEvaluations, myFaultEvaluations[myFaultIdx]);
+        #ifdef DEBUG
+        std::cout << "Debug: Fault " << myFaultIdx << " gate evaluations: " << myFaultEvaluations[myFaultIdx] << std::endl;
+        #endif
+    }
+    const double myFullEvaluations = static_cast<double>(myNumGates) * myNumFaults * aNumTestVectors;
+    std::cout << "Event-driven gate evaluations: " << myTotalEvaluations << " (" << (myFullEvaluations > 0 ? 100.0 * myTotalEvaluations / myFullEvaluations : 0.0) << "% of full re-simulation)"
+              << " | Per fault and vector: " << (aNumTestVectors > 0 ? static_cast<double>(myTotalEvaluations) / myNumFaults / aNumTestVectors : 0.0) << " avg, " << myMaxEvaluations << " max for a single fault" << std::endl;
+    theEventFaultEvaluations = std::move(myFaultEvaluations);
+}
+
+
+void eventFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_event(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+}
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <omp.h>
+
+#include "fframe.h"
+#include "fsim.h"
+
+// Number of test vectors packed into one machine word
+#define OMP_WORD_SIZE 64
+
+// Number of faults handed to a thread at a time
+#define OMP_FAULT_BLOCK_SIZE 64
+
+// Multi-threaded fault simulation on the CPU, a drop-in for cudaFaultSim on machines without a GPU
+// Test vectors are packed OMP_WORD_SIZE to a word and the good machine of every block is simulated in parallel; the
+// (block, fault block) pairs are then shared out dynamically, each thread propagating a fault event-driven through its
+// fanout cone in its own copy of the block's state until every activating vector has reached an output or died out
+void
+faultSim_omp(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+
+    const int myNumFaults = aNumCircuitSignals * 2;
+    const int myNumBlocks = (aNumTestVectors + OMP_WORD_SIZE - 1) / OMP_WORD_SIZE;
+    const int myNumFaultBlocks = (myNumFaults + OMP_FAULT_BLOCK_SIZE - 1) / OMP_FAULT_BLOCK_SIZE;
+
+    std::vector<uint8_t> myIsOutput(aNumCircuitSignals, 0);
+    for (int i = 0; i < aNumCircuitOutputs; i++) {
+        myIsOutput[aCircuitOutputs[i]] = 1;
+    }
+
+    const CudaNetlist myNetlist = {aCircuitStructure, aCircuitConnections};
+    const int myMaxLevel = myNetlist.getMaxLevel(aNumCircuitSignals);
+
+    // Good machine of every block of vectors
+    std::vector<uint64_t> myGoodCircuitStates(static_cast<std::size_t>(myNumBlocks) * aNumCircuitSignals);
+    #pragma omp parallel for schedule(static)
+    for (int myBlockIdx = 0; myBlockIdx < myNumBlocks; myBlockIdx++) {
+        const int myBlockStartIdx = myBlockIdx * OMP_WORD_SIZE;
+        const int myBlockSize = std::min(OMP_WORD_SIZE, aNumTestVectors - myBlockStartIdx);
+        uint64_t* myGoodCircuitState = myGoodCircuitStates.data() + static_cast<std::size_t>(myBlockIdx) * aNumCircuitSignals;
+
+        for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitInputs; myCurrTraversalIdx++) {
+            uint64_t myInputWord = 0;
+            for (int myVectorIdx = 0; myVectorIdx < myBlockSize; myVectorIdx++) {
+                myInputWord |= static_cast<uint64_t>(aTestVectors[static_cast<std::size_t>(myBlockStartIdx + myVectorIdx) * aNumCircuitInputs + myCurrTraversalIdx] & 1) << myVectorIdx;
+            }
+            myGoodCircuitState[aCircuitTraversalOrder[myCurrTraversalIdx]] = myInputWord;
+        }
+        for (int myCurrTraversalIdx = aNumCircuitInputs; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+            int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+            myGoodCircuitState[myCurrentGateIdx] = evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myGoodCircuitState, myCurrentGateIdx);
+        }
+    }
+
+    #pragma omp parallel
+    {
+        // Per-thread faulty machine and event queues
+        std::vector<uint64_t> myFaultyCircuitState(aNumCircuitSignals);
+        EventPropagator<uint64_t> myPropagator(aNumCircuitSignals, myMaxLevel);
+        int myLoadedBlockIdx = -1;
+
+        #pragma omp for collapse(2) schedule(dynamic)
+        for (int myBlockIdx = 0; myBlockIdx < myNumBlocks; myBlockIdx++) {
+            for (int myFaultBlockIdx = 0; myFaultBlockIdx < myNumFaultBlocks; myFaultBlockIdx++) {
+                const int myBlockStartIdx = myBlockIdx * OMP_WORD_SIZE;
+                const int myBlockSize = std::min(OMP_WORD_SIZE, aNumTestVectors - myBlockStartIdx);
+                const uint64_t myValidMask = (myBlockSize == OMP_WORD_SIZE) ? ~0ULL : ((1ULL << myBlockSize) - 1);
+                const uint64_t* myGoodCircuitState = myGoodCircuitStates.data() + static_cast<std::size_t>(myBlockIdx) * aNumCircuitSignals;
+
+                if (myLoadedBlockIdx != myBlockIdx) {
+                    std::copy(myGoodCircuitState, myGoodCircuitState + aNumCircuitSignals, myFaultyCircuitState.begin());
+                    myLoadedBlockIdx = myBlockIdx;
+                }
+
+                const int myLastFaultIdx = std::min(myNumFaults, (myFaultBlockIdx + 1) * OMP_FAULT_BLOCK_SIZE);
+                for (int myFaultIdx = myFaultBlockIdx * OMP_FAULT_BLOCK_SIZE; myFaultIdx < myLastFaultIdx; myFaultIdx++) {
+                    const int myFaultSignal = myFaultIdx / 2;
+                    const uint64_t myFaultWord = (myFaultIdx % 2 == 0) ? 0ULL : ~0ULL;
+                    const uint64_t myActivatedMask = (myGoodCircuitState[myFaultSignal] ^ myFaultWord) & myValidMask;
+                    uint64_t myDetectedMask = 0;
+
+                    if (myActivatedMask) {
+                        // Nothing left to find once every activating vector has detected the fault
+                        myPropagator.propagate(myNetlist, myFaultyCircuitState, myFaultSignal, myFaultWord,
+                            [&](int aGate, const std::vector<uint64_t>& aState) { return evaluateGate(aCircuitStructure[aGate], aCircuitConnections, aState.data(), aGate); },
+                            [&](int aSignal, uint64_t aValue) {
+                                if (myIsOutput[aSignal]) {
+                                    myDetectedMask |= (aValue ^ myGoodCircuitState[aSignal]) & myValidMask;
+                                }
+                            },
+                            [&]() { return myDetectedMask == myActivatedMask; });
+
+                        // Restore the fault-free values for the next fault
+                        myPropagator.restore(myFaultyCircuitState, myGoodCircuitState);
+                    }
+
+                    for (int myVectorIdx = 0; myVectorIdx < myBlockSize; myVectorIdx++) {
+                        aDetectedFaults[static_cast<std::size_t>(myBlockStartIdx + myVectorIdx) * myNumFaults + myFaultIdx] = (myDetectedMask >> myVectorIdx) & 1;
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "OpenMP threads: " << omp_get_max_threads() << " | Work items: " << myNumBlocks << " vector blocks x " << myNumFaultBlocks << " fault blocks" << std::endl;
+}
+
+
+void ompFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_omp(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "fframe.h"
+
+// Number of faulty machines packed into one machine word
+#define PFS_WORD_SIZE 64
+
+// Parallel-fault simulation (PFS) on the CPU
+// Faults are packed PFS_WORD_SIZE to a word in fault index order, so word w holds both faults of signals 32w to 32w + 31.
+// Each signal carries precomputed insertion masks that force its own two bits, applied when its word is simulated.
+// Per test vector the fault-free machine is simulated once, each fault word then re-simulates the circuit from
+// the first of its signals in traversal order; results use the same layout as the serial simulation
+void
+faultSim_pfs(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+
+    const int myNumFaults = aNumCircuitSignals * 2;
+    const int myNumFaultWords = (myNumFaults + PFS_WORD_SIZE - 1) / PFS_WORD_SIZE;
+
+    // Fault insertion masks - a stuck-at-0 bit is cleared by the AND mask, a stuck-at-1 bit set by the OR mask
+    std::vector<uint64_t> myInsertAndMasks(aNumCircuitSignals);
+    std::vector<uint64_t> myInsertOrMasks(aNumCircuitSignals);
+    std::vector<int> myFirstTraversalIdx(myNumFaultWords, aNumCircuitSignals);
+    for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+        int mySignal = aCircuitTraversalOrder[myCurrTraversalIdx];
+        myInsertAndMasks[mySignal] = ~(1ULL << ((2 * mySignal) % PFS_WORD_SIZE));
+        myInsertOrMasks[mySignal] = 1ULL << ((2 * mySignal + 1) % PFS_WORD_SIZE);
+        int myFaultWord = (2 * mySignal) / PFS_WORD_SIZE;
+        myFirstTraversalIdx[myFaultWord] = std::min(myFirstTraversalIdx[myFaultWord], myCurrTraversalIdx);
+    }
+
+    std::vector<uint64_t> myGoodCircuitState(aNumCircuitSignals);
+    std::vector<uint64_t> myFaultyCircuitState(aNumCircuitSignals);
+
+    for (int myTestVectorIdx = 0; myTestVectorIdx < aNumTestVectors; myTestVectorIdx++) {
+
+        // Fault-free machine, its value repeated in every bit
+        for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitInputs; myCurrTraversalIdx++) {
+            myGoodCircuitState[aCircuitTraversalOrder[myCurrTraversalIdx]] = (aTestVectors[static_cast<std::size_t>(myTestVectorIdx) * aNumCircuitInputs + myCurrTraversalIdx] & 1) ? ~0ULL : 0ULL;
+        }
+        for (int myCurrTraversalIdx = aNumCircuitInputs; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+            int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+            myGoodCircuitState[myCurrentGateIdx] = evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myGoodCircuitState.data(), myCurrentGateIdx);
+        }
+        myFaultyCircuitState = myGoodCircuitState;
+
+        for (int myFaultWord = 0; myFaultWord < myNumFaultWords; myFaultWord++) {
+            // Signals before the first fault site of the word are fault-free in all of its machines
+            for (int myCurrTraversalIdx = myFirstTraversalIdx[myFaultWord]; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+                int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+                uint64_t myNewCircuitVal = (myCurrTraversalIdx < aNumCircuitInputs) ? myGoodCircuitState[myCurrentGateIdx] : evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myFaultyCircuitState.data(), myCurrentGateIdx);
+                if ((2 * myCurrentGateIdx) / PFS_WORD_SIZE == myFaultWord) {
+                    myNewCircuitVal = (myNewCircuitVal & myInsertAndMasks[myCurrentGateIdx]) | myInsertOrMasks[myCurrentGateIdx];
+                }
+                myFaultyCircuitState[myCurrentGateIdx] = myNewCircuitVal;
+            }
+
+            uint64_t myDetectedMask = 0;
+            for (int i = 0; i < aNumCircuitOutputs; i++) {
+                myDetectedMask |= myGoodCircuitState[aCircuitOutputs[i]] ^ myFaultyCircuitState[aCircuitOutputs[i]];
+            }
+            const int myWordStartFaultIdx = myFaultWord * PFS_WORD_SIZE;
+            const int myWordSize = std::min(PFS_WORD_SIZE, myNumFaults - myWordStartFaultIdx);
+            for (int myBitIdx = 0; myBitIdx < myWordSize; myBitIdx++) {
+                aDetectedFaults[static_cast<std::size_t>(myTestVectorIdx) * myNumFaults + myWordStartFaultIdx + myBitIdx] = (myDetectedMask >> myBitIdx) & 1;
+            }
+
+            // Restore the fault-free values for the next word
+            for (int myCurrTraversalIdx = myFirstTraversalIdx[myFaultWord]; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+                int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+                myFaultyCircuitState[myCurrentGateIdx] = myGoodCircuitState[myCurrentGateIdx];
+            }
+        }
+    }
+}
+
+
+void pfsFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_pfs(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+}
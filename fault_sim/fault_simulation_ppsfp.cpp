@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "fframe.h"
+
+// Number of test vectors packed into one machine word
+#define PPSFP_WORD_SIZE 64
+
+// Parallel-pattern single-fault propagation (PPSFP) on the CPU
+// Test vectors are packed PPSFP_WORD_SIZE to a word, the good machine is simulated once per block of vectors, and each
+// fault is injected by forcing its word to all zeros or ones and re-simulating only the signals after it in traversal order
+// Faults not activated by any vector of the block are skipped; results use the same layout as the serial simulation
+void
+faultSim_ppsfp(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+
+    std::vector<int> myTraversalPosition(aNumCircuitSignals);
+    for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+        myTraversalPosition[aCircuitTraversalOrder[myCurrTraversalIdx]] = myCurrTraversalIdx;
+    }
+
+    std::vector<uint64_t> myGoodCircuitState(aNumCircuitSignals);
+    std::vector<uint64_t> myFaultyCircuitState(aNumCircuitSignals);
+
+    for (int myBlockStartIdx = 0; myBlockStartIdx < aNumTestVectors; myBlockStartIdx += PPSFP_WORD_SIZE) {
+        const int myBlockSize = std::min(PPSFP_WORD_SIZE, aNumTestVectors - myBlockStartIdx);
+        const uint64_t myValidMask = (myBlockSize == PPSFP_WORD_SIZE) ? ~0ULL : ((1ULL << myBlockSize) - 1);
+
+        // Pack the inputs, bit i of a word holds the value under test vector myBlockStartIdx + i
+        for (int myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitInputs; myCurrTraversalIdx++) {
+            uint64_t myInputWord = 0;
+            for (int myVectorIdx = 0; myVectorIdx < myBlockSize; myVectorIdx++) {
+                myInputWord |= static_cast<uint64_t>(aTestVectors[static_cast<std::size_t>(myBlockStartIdx + myVectorIdx) * aNumCircuitInputs + myCurrTraversalIdx] & 1) << myVectorIdx;
+            }
+            myGoodCircuitState[aCircuitTraversalOrder[myCurrTraversalIdx]] = myInputWord;
+        }
+
+        // Good machine, once per block
+        for (int myCurrTraversalIdx = aNumCircuitInputs; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+            int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+            myGoodCircuitState[myCurrentGateIdx] = evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myGoodCircuitState.data(), myCurrentGateIdx);
+        }
+        myFaultyCircuitState = myGoodCircuitState;
+
+        for (int myFaultIdx = 0; myFaultIdx < aNumCircuitSignals * 2; myFaultIdx++) {
+            const int myFaultSignal = myFaultIdx / 2;
+            const uint64_t myFaultWord = (myFaultIdx % 2 == 0) ? 0ULL : ~0ULL;
+            uint64_t myDetectedMask = 0;
+
+            if ((myGoodCircuitState[myFaultSignal] ^ myFaultWord) & myValidMask) {
+                const int myFirstTraversalIdx = std::max(myTraversalPosition[myFaultSignal] + 1, aNumCircuitInputs);
+                myFaultyCircuitState[myFaultSignal] = myFaultWord;
+                for (int myCurrTraversalIdx = myFirstTraversalIdx; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+                    int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+                    myFaultyCircuitState[myCurrentGateIdx] = evaluateGate(aCircuitStructure[myCurrentGateIdx], aCircuitConnections, myFaultyCircuitState.data(), myCurrentGateIdx);
+                }
+                for (int i = 0; i < aNumCircuitOutputs; i++) {
+                    myDetectedMask |= myGoodCircuitState[aCircuitOutputs[i]] ^ myFaultyCircuitState[aCircuitOutputs[i]];
+                }
+                myDetectedMask &= myValidMask;
+
+                // Restore the fault-free values for the next fault
+                myFaultyCircuitState[myFaultSignal] = myGoodCircuitState[myFaultSignal];
+                for (int myCurrTraversalIdx = myFirstTraversalIdx; myCurrTraversalIdx < aNumCircuitSignals; myCurrTraversalIdx++) {
+                    int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
+                    myFaultyCircuitState[myCurrentGateIdx] = myGoodCircuitState[myCurrentGateIdx];
+                }
+            }
+
+            for (int myVectorIdx = 0; myVectorIdx < myBlockSize; myVectorIdx++) {
+                aDetectedFaults[static_cast<std::size_t>(myBlockStartIdx + myVectorIdx) * (aNumCircuitSignals * 2) + myFaultIdx] = (myDetectedMask >> myVectorIdx) & 1;
+            }
+        }
+    }
+}
+
+
+void ppsfpFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_ppsfp(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+}
@@ -1,29 +1,26 @@
 #include <stdio.h>
+#include <vector>
 
 #include "fframe.h"
 
-// Data structure memory limits
-#define LIMIT_NUM_SIGNALS 10240
-
 // Serial implementation of fault simulation provided the CUDA-friendly input and output data structures
 void
-faultSim_serial(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+faultSim_serial(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    // Golden circuit outputs and circuit state, sized to the circuit
+    std::vector<uint8_t> myCorrectOutputs(aNumCircuitOutputs);
+    std::vector<uint8_t> myLocalCircuitState(aNumCircuitSignals);
+
     // Iterate through all provided test vectors
     for (int myTestVectorIdx = 0; myTestVectorIdx < aNumTestVectors; myTestVectorIdx++) {
 
-        // Initialize golden circuit output structures
-        uint8_t myCorrectOutputs[LIMIT_NUM_SIGNALS];
-
         // Iterate through all possible faults
         for (int myFaultIdx = 0; myFaultIdx < (aNumCircuitSignals * 2) + 1; myFaultIdx++) {
 
-            // Initialize circuit state array
-            uint8_t myLocalCircuitState[LIMIT_NUM_SIGNALS];
             int myCurrTraversalIdx;
 
             // Traverse through the inputs of the circuit to populate the state
             for (myCurrTraversalIdx = 0; myCurrTraversalIdx < aNumCircuitInputs; myCurrTraversalIdx++) {
-                uint8_t myNewCircuitVal = aTestVectors[myTestVectorIdx*aNumCircuitInputs + myCurrTraversalIdx];
+                uint8_t myNewCircuitVal = aTestVectors[static_cast<std::size_t>(myTestVectorIdx)*aNumCircuitInputs + myCurrTraversalIdx];
 
                 // Override state if the signal corresponds to the current faultIdx
                 if ((myFaultIdx != 0) && ((myFaultIdx-1) / 2) == aCircuitTraversalOrder[myCurrTraversalIdx]){
@@ -43,7 +40,7 @@ faultSim_serial(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircu
 
                 int myCurrentGateIdx = aCircuitTraversalOrder[myCurrTraversalIdx];
                 CudaGate myCurrGate = aCircuitStructure[myCurrentGateIdx];
-                uint8_t myNewCircuitVal = myLocalCircuitState[myCurrGate.fanin[0]];
+                uint8_t myNewCircuitVal = myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset]];
 
                 // Update circuit signal state based on signal type
                 switch (myCurrGate.gateType)
@@ -51,37 +48,37 @@ faultSim_serial(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircu
                 // Determine output value given all current inputs (guaranteed to be determinable due to predetermined traversal order)
                 case CudaGateType::AND:
                     for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                        myNewCircuitVal &= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                        myNewCircuitVal &= myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset + myInputIdx]];
                     }
                     break;
                 case CudaGateType::OR:
                     for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                        myNewCircuitVal |= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                        myNewCircuitVal |= myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset + myInputIdx]];
                     }
                     break;
                 case CudaGateType::NOT:
-                    myNewCircuitVal = !myCurrGate.fanin[0];
+                    myNewCircuitVal = !myNewCircuitVal;
                     break;
                 case CudaGateType::XOR:
                     for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                        myNewCircuitVal ^= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                        myNewCircuitVal ^= myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset + myInputIdx]];
                     }
                     break;
                 case CudaGateType::NAND:
                     for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                        myNewCircuitVal &= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                        myNewCircuitVal &= myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset + myInputIdx]];
                     }
                     myNewCircuitVal = !myNewCircuitVal;
                     break;
                 case CudaGateType::NOR:
                     for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                        myNewCircuitVal |= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                        myNewCircuitVal |= myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset + myInputIdx]];
                     }
                     myNewCircuitVal = !myNewCircuitVal;
                     break;
                 case CudaGateType::XNOR:
                     for (int myInputIdx = 1; myInputIdx < myCurrGate.faninSize; myInputIdx++) {
-                        myNewCircuitVal ^= myLocalCircuitState[myCurrGate.fanin[myInputIdx]];
+                        myNewCircuitVal ^= myLocalCircuitState[aCircuitConnections[myCurrGate.faninOffset + myInputIdx]];
                     }
                     myNewCircuitVal = !myNewCircuitVal;
                     break;
@@ -121,7 +118,7 @@ faultSim_serial(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircu
 
             // All other faultIdx values compare its own output against golden outputs to determine fault detection
             if (myFaultIdx != 0){
-                int myDetectedFaultsIdx = myTestVectorIdx * (aNumCircuitSignals * 2) + myFaultIdx - 1;
+                std::size_t myDetectedFaultsIdx = static_cast<std::size_t>(myTestVectorIdx) * (aNumCircuitSignals * 2) + myFaultIdx - 1;
                 aDetectedFaults[myDetectedFaultsIdx] = 0;
                 for (int i = 0; i < aNumCircuitOutputs; i++) {
 
@@ -138,6 +135,6 @@ faultSim_serial(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircu
 }
 
 
-void serialFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
-    faultSim_serial(aNumCircuitSignals, aCircuitStructure, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
+void serialFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults) {
+    faultSim_serial(aNumCircuitSignals, aCircuitStructure, aCircuitConnections, aCircuitTraversalOrder, aNumCircuitInputs, aCircuitInputs, aNumCircuitOutputs, aCircuitOutputs, aNumTestVectors, aTestVectors, aDetectedFaults);
 }
@@ -3,62 +3,70 @@
 
 
 // Iterate through existing parsed circuit structure and populate CUDA-friendly data structures
-void createCircuitStructure(std::shared_ptr<CudaGate[]> aCircuitStructure, Circuit& aCircuit, std::set<std::string> aCircuitMapping) {
+// Signals keep their circuit IDs as array indices, so no name lookup is needed
+void createCircuitStructure(std::shared_ptr<CudaGate[]> aCircuitStructure, std::vector<int>& aCircuitConnections, const CircuitTopology& aCircuit) {
 
-    for (auto& [myCircuitSignal, myCircuitGate] : aCircuit.theCircuit){
-        #ifdef DEBUG
-        std::cout << "Debug: Processing: " << myCircuitSignal << " | Fanin Size: " << myCircuitGate.inputs.size() << " | Fanout Size: " << myCircuitGate.outputs.size() << std::endl;
-        #endif
+    // Lay out the connections gate by gate, the fanins of a gate directly followed by its fanouts
+    aCircuitConnections.assign(aCircuit.theFanins.size() + aCircuit.theFanouts.size(), 0);
+    int myConnectionOffset = 0;
 
-        // Memory allocation checks
-        if (myCircuitGate.inputs.size() > MAX_FANIN_SIZE){
-            std::cout << "MAX_FANIN_SIZE = " << MAX_FANIN_SIZE << std::endl;
-            std::cout << "Fatal Error: Not enough space allocated to support fanin of size " << myCircuitGate.inputs.size() << std::endl;
-            return;
-        }
-        if (myCircuitGate.outputs.size() > MAX_FANOUT_SIZE){
-            std::cout << "MAX_FANOUT_SIZE = " << MAX_FANOUT_SIZE << std::endl;
-            std::cout << "Fatal Error: Not enough space allocated to support fanout of size " << myCircuitGate.outputs.size() << std::endl;
-            return;
-        }
+    for (int myCircuitSignal = 0; myCircuitSignal < aCircuit.getNumSignals(); myCircuitSignal++){
+        const std::size_t myFaninSize = aCircuit.faninEnd(myCircuitSignal) - aCircuit.faninBegin(myCircuitSignal);
+        const std::size_t myFanoutSize = aCircuit.fanoutEnd(myCircuitSignal) - aCircuit.fanoutBegin(myCircuitSignal);
 
-        // Perform mapping of signals and gates (string to array index)
-        int myMappedSignal = getSignalMapping(aCircuitMapping, myCircuitSignal);
+        #ifdef DEBUG
+        std::cout << "Debug: Processing: " << aCircuit.theSignalNames[myCircuitSignal] << " | Fanin Size: " << myFaninSize << " | Fanout Size: " << myFanoutSize << std::endl;
+        #endif
 
-        if (myCircuitGate.gateType == "BUFF" || myCircuitGate.gateType == "buff"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::BUFF;
-        } else if (myCircuitGate.gateType == "NOT" || myCircuitGate.gateType == "not"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::NOT;
-        } else if (myCircuitGate.gateType == "AND" || myCircuitGate.gateType == "and"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::AND;
-        } else if (myCircuitGate.gateType == "NAND" || myCircuitGate.gateType == "nand"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::NAND;
-        } else if (myCircuitGate.gateType == "OR" || myCircuitGate.gateType == "or"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::OR;
-        } else if (myCircuitGate.gateType == "NOR" || myCircuitGate.gateType == "nor"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::NOR;
-        } else if (myCircuitGate.gateType == "XOR" || myCircuitGate.gateType == "xor"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::XOR;
-        } else if (myCircuitGate.gateType == "XNOR" || myCircuitGate.gateType == "xnor"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::XNOR;
-        } else if (myCircuitGate.gateType == "INPUT" || myCircuitGate.gateType == "input"){
-            aCircuitStructure[myMappedSignal].gateType = CudaGateType::INPUT;
-        } else {
-            std::cout << "Error: Unable to match gate " << myCircuitGate.gateType << std::endl;
+        switch (aCircuit.theGateTypes[myCircuitSignal]) {
+        case GateType::BUFF:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::BUFF;
+            break;
+        case GateType::NOT:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::NOT;
+            break;
+        case GateType::AND:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::AND;
+            break;
+        case GateType::NAND:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::NAND;
+            break;
+        case GateType::OR:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::OR;
+            break;
+        case GateType::NOR:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::NOR;
+            break;
+        case GateType::XOR:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::XOR;
+            break;
+        case GateType::XNOR:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::XNOR;
+            break;
+        case GateType::INPUT:
+            aCircuitStructure[myCircuitSignal].gateType = CudaGateType::INPUT;
+            break;
+        default:
+            std::cout << "Error: Unable to match gate " << getGateTypeString(aCircuit.theGateTypes[myCircuitSignal]) << std::endl;
+            break;
         }
 
-        // Fill in array size parameters
-        aCircuitStructure[myMappedSignal].faninSize = myCircuitGate.inputs.size();
-        aCircuitStructure[myMappedSignal].fanoutSize = myCircuitGate.outputs.size();
+        // Fill in array size and offset parameters
+        aCircuitStructure[myCircuitSignal].faninSize = myFaninSize;
+        aCircuitStructure[myCircuitSignal].fanoutSize = myFanoutSize;
+        aCircuitStructure[myCircuitSignal].faninOffset = myConnectionOffset;
+        aCircuitStructure[myCircuitSignal].fanoutOffset = myConnectionOffset + myFaninSize;
+        aCircuitStructure[myCircuitSignal].level = aCircuit.theLevels[myCircuitSignal];
+        myConnectionOffset += myFaninSize + myFanoutSize;
 
         // Populate fanin signal details
         #ifdef DEBUG
         std::cout << "Debug: Fanin Signals: ";
         #endif
-        for (std::size_t myFaninSignalIdx = 0; myFaninSignalIdx < myCircuitGate.inputs.size(); myFaninSignalIdx++){
-            aCircuitStructure[myMappedSignal].fanin[myFaninSignalIdx] = getSignalMapping(aCircuitMapping, myCircuitGate.inputs[myFaninSignalIdx]);
+        for (std::size_t myFaninSignalIdx = 0; myFaninSignalIdx < myFaninSize; myFaninSignalIdx++){
+            aCircuitConnections[aCircuitStructure[myCircuitSignal].faninOffset + myFaninSignalIdx] = aCircuit.faninBegin(myCircuitSignal)[myFaninSignalIdx];
             #ifdef DEBUG
-            std::cout << aCircuitStructure[myMappedSignal].fanin[myFaninSignalIdx] << " ";
+            std::cout << aCircuitConnections[aCircuitStructure[myCircuitSignal].faninOffset + myFaninSignalIdx] << " ";
             #endif
         }
 
@@ -66,10 +74,10 @@ void createCircuitStructure(std::shared_ptr<CudaGate[]> aCircuitStructure, Circu
         #ifdef DEBUG
         std::cout << "\nDebug: Fanout Signals: ";
         #endif
-        for (std::size_t myFanoutSignalIdx = 0; myFanoutSignalIdx < myCircuitGate.outputs.size(); myFanoutSignalIdx++){
-            aCircuitStructure[myMappedSignal].fanout[myFanoutSignalIdx] = getSignalMapping(aCircuitMapping, myCircuitGate.outputs[myFanoutSignalIdx]);
+        for (std::size_t myFanoutSignalIdx = 0; myFanoutSignalIdx < myFanoutSize; myFanoutSignalIdx++){
+            aCircuitConnections[aCircuitStructure[myCircuitSignal].fanoutOffset + myFanoutSignalIdx] = aCircuit.fanoutBegin(myCircuitSignal)[myFanoutSignalIdx];
             #ifdef DEBUG
-            std::cout << aCircuitStructure[myMappedSignal].fanout[myFanoutSignalIdx] << " ";
+            std::cout << aCircuitConnections[aCircuitStructure[myCircuitSignal].fanoutOffset + myFanoutSignalIdx] << " ";
             #endif
         }
         #ifdef DEBUG
@@ -81,12 +89,12 @@ void createCircuitStructure(std::shared_ptr<CudaGate[]> aCircuitStructure, Circu
 
 
 // Helper method to populate CUDA-friendly circuit output data structure
-void createCircuitOutputs(std::shared_ptr<int[]> aCircuitOutputs, Circuit& aCircuit, std::set<std::string> aCircuitMapping){
+void createCircuitOutputs(std::shared_ptr<int[]> aCircuitOutputs, const CircuitTopology& aCircuit){
     #ifdef DEBUG
     std::cout << "\nDebug: Populating circuit output array: ";
     #endif
     for (std::size_t myOutputIdx = 0; myOutputIdx < aCircuit.theCircuitOutputs.size(); myOutputIdx++){
-        aCircuitOutputs[myOutputIdx] = getSignalMapping(aCircuitMapping, aCircuit.theCircuitOutputs[myOutputIdx]);
+        aCircuitOutputs[myOutputIdx] = aCircuit.theCircuitOutputs[myOutputIdx];
         #ifdef DEBUG
         std::cout << aCircuitOutputs[myOutputIdx] << " ";
         #endif
@@ -97,17 +105,21 @@ void createCircuitOutputs(std::shared_ptr<int[]> aCircuitOutputs, Circuit& aCirc
 }
 
 
-// Creates set of all existing signals
-std::set<std::string> createSignalsSet(Circuit& aCircuit) {
-    std::set<std::string> mySignals = std::set<std::string>();
-    for (auto& [myCircuitName, myCircuitGate] : aCircuit.theCircuitState) {
-        mySignals.insert(myCircuitName);
-    }
-    return mySignals;
-}
-
+// Traversal order of the simulation - the inputs in test vector column order, then every other signal in the
+// topological order the circuit was levelized in, so each gate follows all of its fanins
+std::vector<int> createTraversalOrder(const CircuitTopology& aCircuit, std::shared_ptr<int[]> aCircuitInputs, int aNumCircuitInputs) {
+    std::vector<int> myTraversalOrder = std::vector<int>();
+    myTraversalOrder.reserve(aCircuit.getNumSignals());
 
-// Maps signal name to array index
-int getSignalMapping(std::set<std::string> aCircuitMapping, std::string aSignal){
-    return std::distance(aCircuitMapping.begin(), aCircuitMapping.find(aSignal));
+    std::vector<std::uint8_t> myIsInput(aCircuit.getNumSignals(), 0);
+    for (int myInputIdx = 0; myInputIdx < aNumCircuitInputs; myInputIdx++){
+        myTraversalOrder.push_back(aCircuitInputs[myInputIdx]);
+        myIsInput[aCircuitInputs[myInputIdx]] = 1;
+    }
+    for (int mySignal : aCircuit.theTopologicalOrder){
+        if (!myIsInput[mySignal]) {
+            myTraversalOrder.push_back(mySignal);
+        }
+    }
+    return myTraversalOrder;
 }
@@ -2,32 +2,93 @@
 #define FAULT_SIM_H
 
 #include <cstdint>
-#include <set>
 #include <string>
+#include <vector>
+#include <type_traits>
 
 #include "cframe.h"
 
-// Constant-sized circuit details
-#define MAX_FANIN_SIZE 15
-#define MAX_FANOUT_SIZE 15
-
 // Supported gate types
 enum class CudaGateType : uint8_t { AND, OR, NOT, XOR, NAND, NOR, BUFF, XNOR, INPUT};
 
 // CUDA-friendly gate struct
+// Fanins and fanouts are ranges of one connection array shared by all gates (CSR), starting at their offsets
 struct CudaGate {
     CudaGateType gateType;
     int faninSize;
     int fanoutSize;
-    int fanin[MAX_FANIN_SIZE];
-    int fanout[MAX_FANOUT_SIZE];
+    int faninOffset;
+    int fanoutOffset;
+    // Level from the circuit levelization, every gate strictly above all of its fanins
+    int level;
+};
+
+// Netlist view of the circuit structure, for the event propagator shared with the ATPG (fsim.h)
+struct CudaNetlist {
+    const CudaGate* theGates;
+    const int* theConnections;
+
+    int getLevel(int aSignal) const { return theGates[aSignal].level; }
+
+    template <typename Visitor>
+    void forEachFanout(int aSignal, Visitor aVisit) const {
+        for (int myOutputIdx = 0; myOutputIdx < theGates[aSignal].fanoutSize; myOutputIdx++) {
+            aVisit(theConnections[theGates[aSignal].fanoutOffset + myOutputIdx]);
+        }
+    }
+
+    // Highest level among the first aNumSignals gates
+    int getMaxLevel(int aNumSignals) const {
+        int myMaxLevel = 0;
+        for (int mySignal = 0; mySignal < aNumSignals; mySignal++) {
+            myMaxLevel = std::max(myMaxLevel, theGates[mySignal].level);
+        }
+        return myMaxLevel;
+    }
 };
 
-void createCircuitStructure(std::shared_ptr<CudaGate[]> aCircuitStructure, Circuit& aCircuit, std::set<std::string> aCircuitMapping);
-void createCircuitOutputs(std::shared_ptr<int[]> aCircuitOutputs, Circuit& aCircuit, std::set<std::string> aCircuitMapping);
+// Evaluate a gate on the circuit state (inputs keep the value already in the state)
+// A state holds either one 0/1 value per signal (uint8_t) or one packed word per signal (uint64_t), one vector or
+// faulty machine per bit; single values are inverted logically so they stay 0 or 1
+template <typename Value>
+inline Value evaluateGate(const CudaGate& aGate, const int* aCircuitConnections, const Value* aCircuitState, int aSignal) {
+    static_assert(std::is_same_v<Value, uint8_t> || std::is_same_v<Value, uint64_t>, "State must be single values or packed words");
+    auto invert = [](Value aValue) -> Value { if constexpr (std::is_same_v<Value, uint8_t>) { return !aValue; } else { return ~aValue; } };
+
+    Value myNewCircuitVal = aCircuitState[aCircuitConnections[aGate.faninOffset]];
+
+    switch (aGate.gateType)
+    {
+    case CudaGateType::AND:
+    case CudaGateType::NAND:
+        for (int myInputIdx = 1; myInputIdx < aGate.faninSize; myInputIdx++) {
+            myNewCircuitVal &= aCircuitState[aCircuitConnections[aGate.faninOffset + myInputIdx]];
+        }
+        return (aGate.gateType == CudaGateType::NAND) ? invert(myNewCircuitVal) : myNewCircuitVal;
+    case CudaGateType::OR:
+    case CudaGateType::NOR:
+        for (int myInputIdx = 1; myInputIdx < aGate.faninSize; myInputIdx++) {
+            myNewCircuitVal |= aCircuitState[aCircuitConnections[aGate.faninOffset + myInputIdx]];
+        }
+        return (aGate.gateType == CudaGateType::NOR) ? invert(myNewCircuitVal) : myNewCircuitVal;
+    case CudaGateType::XOR:
+    case CudaGateType::XNOR:
+        for (int myInputIdx = 1; myInputIdx < aGate.faninSize; myInputIdx++) {
+            myNewCircuitVal ^= aCircuitState[aCircuitConnections[aGate.faninOffset + myInputIdx]];
+        }
+        return (aGate.gateType == CudaGateType::XNOR) ? invert(myNewCircuitVal) : myNewCircuitVal;
+    case CudaGateType::NOT:
+        return invert(myNewCircuitVal);
+    case CudaGateType::BUFF:
+        return myNewCircuitVal;
+    default:
+        return aCircuitState[aSignal];
+    }
+}
 
-std::set<std::string> createSignalsSet(Circuit& aCircuit);
+void createCircuitStructure(std::shared_ptr<CudaGate[]> aCircuitStructure, std::vector<int>& aCircuitConnections, const CircuitTopology& aCircuit);
+void createCircuitOutputs(std::shared_ptr<int[]> aCircuitOutputs, const CircuitTopology& aCircuit);
 
-int getSignalMapping(std::set<std::string> aCircuitMapping, std::string aSignal);
+std::vector<int> createTraversalOrder(const CircuitTopology& aCircuit, std::shared_ptr<int[]> aCircuitInputs, int aNumCircuitInputs);
 
 #endif
\ No newline at end of file
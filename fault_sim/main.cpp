@@ -1,13 +1,36 @@
 #include <iostream>
+#include <cmath>
+#include <omp.h>
 
 #include "cframe.h"
 #include "fframe.h"
 #include "CycleTimer.h"
 
-void cudaFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+#ifndef NO_CUDA
+void cudaFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
 void printCudaInfo();
-
-void serialFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+#endif
+
+void serialFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+void ppsfpFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+void pfsFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+void eventFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+void cptFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+void deductiveFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+void ompFaultSim(int aNumCircuitSignals, CudaGate* aCircuitStructure, int* aCircuitConnections, int* aCircuitTraversalOrder, int aNumCircuitInputs, int* aCircuitInputs, int aNumCircuitOutputs, int* aCircuitOutputs, int aNumTestVectors, uint8_t* aTestVectors, uint8_t* aDetectedFaults);
+
+// Per-fault gate evaluations of the event-driven backend, written to a file per run
+extern std::vector<long> theEventFaultEvaluations;
+
+
+// Word-parallel backend with the least estimated work for the given workload
+// PPSFP simulates each fault once per block of 64 vectors over about half of the circuit, PFS the whole circuit once
+// per vector for each word of 64 faults - so PFS wins while the vectors cannot fill a word, e.g. grading a single new one
+std::string chooseFaultSimBackend(int aNumTestVectors, int aNumFaults) {
+    const double myPPSFPCost = std::ceil(aNumTestVectors / 64.0) * aNumFaults / 2.0;
+    const double myPFSCost = aNumTestVectors * std::ceil(aNumFaults / 64.0);
+    return (myPFSCost < myPPSFPCost) ? "pfs" : "ppsfp";
+}
 
 
 // Input file parsing
@@ -28,27 +51,44 @@ std::vector<std::string> tokenize_file_name(std::string s) {
 
 int main(int argc, char** argv) {
 
-    if (argc != 3) {
-        std::cout << "Need to supply input circuit file and test vectors" << std::endl;
+    if (argc != 3 && argc != 4) {
+        std::cout << "Need to supply input circuit file and test vectors, optionally followed by the parallel backend (cuda, omp, ppsfp, pfs, event, cpt, deductive or auto)" << std::endl;
         return -1;
     }
 
-    // Parse circuit structure
-    std::unique_ptr<Circuit> myCircuit = std::make_unique<Circuit>(argv[1]);
+    // Parallel backend timed against the serial simulation, the multi-threaded CPU one when built without CUDA
+    #ifdef NO_CUDA
+    std::string myBackend = (argc == 4) ? std::string(argv[3]) : "omp";
+    if (myBackend == "cuda") {
+        std::cout << "Error: Built without CUDA, use the omp backend instead" << std::endl;
+        return -1;
+    }
+    #else
+    std::string myBackend = (argc == 4) ? std::string(argv[3]) : "cuda";
+    #endif
+    if (myBackend != "cuda" && myBackend != "omp" && myBackend != "ppsfp" && myBackend != "pfs" && myBackend != "event" && myBackend != "cpt" && myBackend != "deductive" && myBackend != "auto") {
+        std::cout << "Error: Unknown fault simulation backend " << myBackend << std::endl;
+        return -1;
+    }
 
-    std::set<std::string> myCircuitMapping = createSignalsSet(*myCircuit);
+    // Parse circuit structure - levelized and name-indexed once, as for the ATPG
+    double myParseStartTime = CycleTimer::currentSeconds();
+    std::unique_ptr<CircuitTopology> myCircuit = std::make_unique<CircuitTopology>(argv[1]);
+    const int myNumCircuitSignals = myCircuit->getNumSignals();
+    double myParseEndTime = CycleTimer::currentSeconds();
 
     #ifdef DEBUG
     std::cout << "\nDebug: Printing circuit signal mapping" << std::endl;
-    for (const auto& myElem : myCircuitMapping) {
-        std::cout << std::setw(30) << myElem << ": " << getSignalMapping(myCircuitMapping, myElem) << std::endl;
+    for (int mySignal = 0; mySignal < myNumCircuitSignals; mySignal++) {
+        std::cout << std::setw(30) << myCircuit->theSignalNames[mySignal] << ": " << mySignal << std::endl;
     }
     std::cout << std::endl;
     #endif
 
     // Parse input circuit from ccframe and generate a CUDA-friendly version
-    std::shared_ptr<CudaGate[]> myCircuitStructure(new CudaGate[myCircuitMapping.size()]);
-    createCircuitStructure(myCircuitStructure, *myCircuit, myCircuitMapping);
+    std::shared_ptr<CudaGate[]> myCircuitStructure(new CudaGate[myNumCircuitSignals]);
+    std::vector<int> myCircuitConnections = std::vector<int>();
+    createCircuitStructure(myCircuitStructure, myCircuitConnections, *myCircuit);
 
     #ifdef DEBUG
     std::cout << "Finished structure" << std::endl;
@@ -60,7 +100,8 @@ int main(int argc, char** argv) {
 
     int myNumCircuitOutputs = myCircuit->theCircuitOutputs.size();
     std::shared_ptr<int[]> myCircuitOutputs(new int[myNumCircuitOutputs]);
-    createCircuitOutputs(myCircuitOutputs, *myCircuit, myCircuitMapping);
+    createCircuitOutputs(myCircuitOutputs, *myCircuit);
+    double myStructureEndTime = CycleTimer::currentSeconds();
 
     // Parse all input test vectors and populate CUDA-friendly data structures
     std::ifstream myTestVectorsFile;
@@ -104,12 +145,13 @@ int main(int argc, char** argv) {
             #endif
             for (int myInputIdx = 0; myInputIdx < myNumCircuitInputs; myInputIdx++){
 
-                if (!vectorContains<std::string>(myCircuit->theCircuitInputs, myLineTokens[myInputIdx + 1])){
+                int myInputSignal = myCircuit->getSignalId(myLineTokens[myInputIdx + 1]);
+                if (myInputSignal < 0 || myCircuit->theGateTypes[myInputSignal] != GateType::INPUT){
                     std::cout << "\nError: Invalid input signal in test vector file" << std::endl;
                     return -1;
                 }
 
-                myCircuitInputs[myInputIdx] = getSignalMapping(myCircuitMapping, myLineTokens[myInputIdx + 1]);
+                myCircuitInputs[myInputIdx] = myInputSignal;
                 #ifdef DEBUG
                 std::cout << myCircuitInputs[myInputIdx] << " ";
                 #endif
@@ -168,59 +210,89 @@ int main(int argc, char** argv) {
     }
     #endif
 
+    double myTestVectorsEndTime = CycleTimer::currentSeconds();
+
     // Determine traversal order of circuit (used by both CUDA and serial CPU implementation)
-    std::vector<int> myTraversalOrderVector = std::vector<int>();
-    for (int i = 0; i < myNumCircuitInputs; i++){
-        myTraversalOrderVector.push_back(myCircuitInputs[i]);
-    }
-    while (myTraversalOrderVector.size() < myCircuitMapping.size()){
-        for (auto& mySignal : myCircuitMapping){
-            if (!vectorContains<int>(myTraversalOrderVector, getSignalMapping(myCircuitMapping, mySignal))) {
-                bool myInputsReady = true;
-                for (auto& myFanin : myCircuit->theCircuit[mySignal].inputs) {
-                    if (!vectorContains<int>(myTraversalOrderVector, getSignalMapping(myCircuitMapping, myFanin))) {
-                        myInputsReady = false;
-                    }
-                }
-                if (myInputsReady) {
-                    myTraversalOrderVector.push_back(getSignalMapping(myCircuitMapping, mySignal));
-                }
-            }
-        }
-    }
+    std::vector<int> myTraversalOrderVector = createTraversalOrder(*myCircuit, myCircuitInputs, myNumCircuitInputs);
+    double myTraversalEndTime = CycleTimer::currentSeconds();
+
+    std::cout << "Info: Setup (s) | Parse: " << (myParseEndTime - myParseStartTime) << " | Structure: " << (myStructureEndTime - myParseEndTime)
+              << " | Test vectors: " << (myTestVectorsEndTime - myStructureEndTime) << " | Traversal order: " << (myTraversalEndTime - myTestVectorsEndTime) << std::endl;
 
     #ifdef DEBUG
     std::cout << "\nFinished populating CUDA input data structures\n" << std::endl;
 
+    #ifndef NO_CUDA
     printCudaInfo();
     #endif
+    #endif
 
     // Initialize output data structures and start CUDA fault simulation
-    std::shared_ptr<std::uint8_t[]> myDetectedFaults(new std::uint8_t[myCircuitMapping.size() * 2 * myNumTestVectors]);
+    // One result per fault and vector, counted in std::size_t since the product overflows an int on large netlists
+    const std::size_t myNumResults = static_cast<std::size_t>(myNumCircuitSignals) * 2 * myNumTestVectors;
+    std::shared_ptr<std::uint8_t[]> myDetectedFaults(new std::uint8_t[myNumResults]);
     #ifdef DEBUG
     std::cout << "\nStarting Parallel Fault Simulation Timer" << std::endl;
     #endif
     double myParallelStartTime = CycleTimer::currentSeconds();
-    cudaFaultSim(myCircuitMapping.size(), myCircuitStructure.get(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    const bool myAutoBackend = (myBackend == "auto");
+    if (myAutoBackend) {
+        myBackend = chooseFaultSimBackend(myNumTestVectors, myNumCircuitSignals * 2);
+    }
+    if (myBackend == "omp") {
+        ompFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    } else if (myBackend == "deductive") {
+        deductiveFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    } else if (myBackend == "cpt") {
+        cptFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    } else if (myBackend == "event") {
+        eventFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    } else if (myBackend == "pfs") {
+        pfsFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    } else if (myBackend == "ppsfp") {
+        ppsfpFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    }
+    #ifndef NO_CUDA
+    else {
+        cudaFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    }
+    #endif
     double myParallelEndTime = CycleTimer::currentSeconds();
     #ifdef DEBUG
     std::cout << "Ending Parallel Fault Simulation Timer" << std::endl;
     #endif
 
+    // The omp backend is timed again, warm, on one thread and on all threads, so its multicore speedup is measured
+    // against itself rather than against the serial oracle
+    const int myNumThreads = omp_get_max_threads();
+    double myOneThreadTime = 0.0;
+    double myAllThreadsTime = 0.0;
+    if (myBackend == "omp") {
+        std::shared_ptr<std::uint8_t[]> myThreadDetectedFaults(new std::uint8_t[myNumResults]);
+        auto timeOmp = [&](int aNumThreads) {
+            omp_set_num_threads(aNumThreads);
+            double myStartTime = CycleTimer::currentSeconds();
+            ompFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myThreadDetectedFaults.get());
+            return CycleTimer::currentSeconds() - myStartTime;
+        };
+        myOneThreadTime = timeOmp(1);
+        myAllThreadsTime = timeOmp(myNumThreads);
+    }
+
     // Print Results
     #ifdef DEBUG
     std::cout << "\n--------------------- Parallel Fault Simulation Results ---------------------" << std::endl;
     for (int myVectorIdx = 0; myVectorIdx < myNumTestVectors; myVectorIdx++) {
         std::cout << "Test Vector: " << myVectorIdx << std::endl;
         int myFaultCnt = 0;
-        for (std::size_t myFaultIdx = 0; myFaultIdx < myCircuitMapping.size() * 2; myFaultIdx+=2) {
-            int mySA0Idx = (myVectorIdx * myCircuitMapping.size() * 2) + myFaultIdx;
-            int mySA1Idx = (myVectorIdx * myCircuitMapping.size() * 2) + myFaultIdx + 1;
-            // std::cout << std::setw(30) << (*std::next(myCircuitMapping.begin(), (myFaultIdx/2))) << " / 0 fault detected: " << static_cast<int>(myDetectedFaults[mySA0Idx]) << std::endl;
-            // std::cout << std::setw(30) << (*std::next(myCircuitMapping.begin(), (myFaultIdx/2))) << " / 1 fault detected: " << static_cast<int>(myDetectedFaults[mySA1Idx]) << std::endl;
+        for (std::size_t myFaultIdx = 0; myFaultIdx < myNumCircuitSignals * 2; myFaultIdx+=2) {
+            int mySA0Idx = (myVectorIdx * myNumCircuitSignals * 2) + myFaultIdx;
+            int mySA1Idx = (myVectorIdx * myNumCircuitSignals * 2) + myFaultIdx + 1;
+            // std::cout << std::setw(30) << myCircuit->theSignalNames[myFaultIdx/2] << " / 0 fault detected: " << static_cast<int>(myDetectedFaults[mySA0Idx]) << std::endl;
+            // std::cout << std::setw(30) << myCircuit->theSignalNames[myFaultIdx/2] << " / 1 fault detected: " << static_cast<int>(myDetectedFaults[mySA1Idx]) << std::endl;
             myFaultCnt += static_cast<int>(myDetectedFaults[mySA0Idx]) + static_cast<int>(myDetectedFaults[mySA1Idx]);
         }
-        std::cout << "Total faults detected: " << myFaultCnt << " / " << (myCircuitMapping.size() * 2) << std::endl;
+        std::cout << "Total faults detected: " << myFaultCnt << " / " << (myNumCircuitSignals * 2) << std::endl;
         std::cout << std::endl;
     }
     #endif
@@ -229,8 +301,10 @@ int main(int argc, char** argv) {
     #ifdef DEBUG
     std::cout << "\nStarting Serial Fault Simulation Timer" << std::endl;
     #endif
+    std::shared_ptr<std::uint8_t[]> myParallelDetectedFaults = myDetectedFaults;
+    myDetectedFaults = std::shared_ptr<std::uint8_t[]>(new std::uint8_t[myNumResults]);
     double mySerialStartTime = CycleTimer::currentSeconds();
-    serialFaultSim(myCircuitMapping.size(), myCircuitStructure.get(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
+    serialFaultSim(myNumCircuitSignals, myCircuitStructure.get(), myCircuitConnections.data(), myTraversalOrderVector.data(), myNumCircuitInputs, myCircuitInputs.get(), myNumCircuitOutputs, myCircuitOutputs.get(), myNumTestVectors, myTestVectors.get(), myDetectedFaults.get());
     double mySerialEndTime = CycleTimer::currentSeconds();
     #ifdef DEBUG
     std::cout << "Ending Serial Fault Simulation Timer" << std::endl;
@@ -242,25 +316,41 @@ int main(int argc, char** argv) {
     for (int myVectorIdx = 0; myVectorIdx < myNumTestVectors; myVectorIdx++) {
         std::cout << "Test Vector: " << myVectorIdx << std::endl;
         int myFaultCnt = 0;
-        for (std::size_t myFaultIdx = 0; myFaultIdx < myCircuitMapping.size() * 2; myFaultIdx+=2) {
-            int mySA0Idx = (myVectorIdx * myCircuitMapping.size() * 2) + myFaultIdx;
-            int mySA1Idx = (myVectorIdx * myCircuitMapping.size() * 2) + myFaultIdx + 1;
-            // std::cout << std::setw(30) << (*std::next(myCircuitMapping.begin(), (myFaultIdx/2))) << " / 0 fault detected: " << static_cast<int>(myDetectedFaults[mySA0Idx]) << std::endl;
-            // std::cout << std::setw(30) << (*std::next(myCircuitMapping.begin(), (myFaultIdx/2))) << " / 1 fault detected: " << static_cast<int>(myDetectedFaults[mySA1Idx]) << std::endl;
+        for (std::size_t myFaultIdx = 0; myFaultIdx < myNumCircuitSignals * 2; myFaultIdx+=2) {
+            int mySA0Idx = (myVectorIdx * myNumCircuitSignals * 2) + myFaultIdx;
+            int mySA1Idx = (myVectorIdx * myNumCircuitSignals * 2) + myFaultIdx + 1;
+            // std::cout << std::setw(30) << myCircuit->theSignalNames[myFaultIdx/2] << " / 0 fault detected: " << static_cast<int>(myDetectedFaults[mySA0Idx]) << std::endl;
+            // std::cout << std::setw(30) << myCircuit->theSignalNames[myFaultIdx/2] << " / 1 fault detected: " << static_cast<int>(myDetectedFaults[mySA1Idx]) << std::endl;
             myFaultCnt += static_cast<int>(myDetectedFaults[mySA0Idx]) + static_cast<int>(myDetectedFaults[mySA1Idx]);
         }
-        std::cout << "Total faults detected: " << myFaultCnt << " / " << (myCircuitMapping.size() * 2) << std::endl;
+        std::cout << "Total faults detected: " << myFaultCnt << " / " << (myNumCircuitSignals * 2) << std::endl;
         std::cout << std::endl;
     }
     #endif
 
+    // The serial simulation is the reference every backend has to match exactly
+    std::size_t myNumMismatches = 0;
+    for (std::size_t myResultIdx = 0; myResultIdx < myNumResults; myResultIdx++) {
+        myNumMismatches += (myParallelDetectedFaults[myResultIdx] != myDetectedFaults[myResultIdx]);
+    }
+    if (myNumMismatches > 0) {
+        std::cout << "Error: " << myBackend << " and serial fault simulation disagree on " << myNumMismatches << " fault/vector pairs" << std::endl;
+    }
+
     // Output statistics to result file
     std::vector<std::string> myTokenizedCircuitFileName = tokenize_file_name(argv[1]);
 
     std::string myBenchName = myTokenizedCircuitFileName[myTokenizedCircuitFileName.size()-2];
 
+    std::cout << "Backend: " << myBackend << (myAutoBackend ? " (auto)" : "") << std::endl;
     std::cout << "Serial Time (s)   " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (mySerialEndTime - mySerialStartTime) << std::endl;
-    std::cout << "Parallel Time (s) " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (myParallelEndTime - myParallelStartTime) << std::endl << std::endl;
+    std::cout << "Parallel Time (s) " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (myParallelEndTime - myParallelStartTime) << std::endl;
+    std::cout << "Speedup           " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (mySerialEndTime - mySerialStartTime) / (myParallelEndTime - myParallelStartTime) << "x" << std::endl;
+    // Against the serial oracle the speedup is mostly algorithmic, the thread speedup is the multicore one
+    if (myBackend == "omp") {
+        std::cout << "Thread speedup    " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << myOneThreadTime / myAllThreadsTime << "x (" << myNumThreads << " threads vs 1)" << std::endl;
+    }
+    std::cout << std::endl;
 
     std::ofstream myOutputFile("benchmarks_results.txt", std::ios::app);
     if (!myOutputFile) {
@@ -268,9 +358,38 @@ int main(int argc, char** argv) {
     }
 
     myOutputFile << "Serial   " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (mySerialEndTime - mySerialStartTime) << std::endl;
-    myOutputFile << "Parallel " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (myParallelEndTime - myParallelStartTime) << std::endl << std::endl;
+    myOutputFile << "Parallel " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (myParallelEndTime - myParallelStartTime) << std::endl;
+    myOutputFile << "Speedup  " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << (mySerialEndTime - mySerialStartTime) / (myParallelEndTime - myParallelStartTime) << "x" << std::endl;
+    if (myBackend == "omp") {
+        myOutputFile << "Threads  " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << myOneThreadTime / myAllThreadsTime << "x (" << myNumThreads << " threads vs 1)" << std::endl;
+    }
+    // Event-driven cost summed over all faults, the cost of each fault goes to its own file per run
+    if (myBackend == "event") {
+        long myTotalEvaluations = 0;
+        long myMaxEvaluations = 0;
+        for (long myEvaluations : theEventFaultEvaluations) {
+            myTotalEvaluations += myEvaluations;
+            myMaxEvaluations = std::max(myMaxEvaluations, myEvaluations);
+        }
+        myOutputFile << "Events   " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " : " << myTotalEvaluations << " gate evaluations, " << myMaxEvaluations << " max for a single fault" << std::endl;
+    }
+    myOutputFile << std::endl;
 
     myOutputFile.close();
 
+    // Event-driven cost of each fault, one line per signal with its stuck-at-0 and stuck-at-1 evaluations
+    if (myBackend == "event") {
+        const std::string myEvaluationsFileName = "event_evaluations_" + myBenchName + "_" + std::to_string(myNumTestVectors) + ".txt";
+        std::ofstream myEvaluationsFile(myEvaluationsFileName);
+        if (!myEvaluationsFile) {
+            std::cout << "Error: Could not open " << myEvaluationsFileName << std::endl;
+        }
+        myEvaluationsFile << "Gate evaluations per fault " << std::setw(6) << myBenchName << " " << std::setw(3) << myNumTestVectors << " (signal : sa0 sa1)" << std::endl;
+        for (int mySignal = 0; mySignal < myNumCircuitSignals; mySignal++) {
+            myEvaluationsFile << std::setw(30) << myCircuit->theSignalNames[mySignal] << " : " << theEventFaultEvaluations[2 * mySignal] << " " << theEventFaultEvaluations[2 * mySignal + 1] << std::endl;
+        }
+        std::cout << "Info: Per-fault gate evaluations written to " << myEvaluationsFileName << std::endl;
+    }
+
     return 0;
 }
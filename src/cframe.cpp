@@ -1,4 +1,10 @@
 #include <sstream>
+#include <cstring>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "cframe.h"
 
@@ -32,7 +38,7 @@ void remove_equals_sign(std::string& s) {
 
 // Splits an ISCAS line and returns vector of tokens consisting
 // of wire names and the type of gate
-static std::vector<std::string> tokenize_line(std::string s) {
+std::vector<std::string> tokenize_line(std::string s) {
     remove_brackets(s);
     remove_commas(s);
     remove_equals_sign(s);
@@ -49,247 +55,1203 @@ static std::vector<std::string> tokenize_line(std::string s) {
 }
 
 
-// Gets the wire name of a string
-static std::vector<std::string> get_wire_names(std::string line) {
-    std::vector<std::string> tokens = tokenize_line(line);
+std::string getSignalStateString(SignalType aSignal){
+    return signalTypeNames.find(aSignal)->second;
+}
 
-    if (tokens[0] == "INPUT" ||
-        tokens[0] == "input" ||
-        tokens[0] == "OUTPUT" ||
-        tokens[0] == "output") {
-        return std::vector<std::string>({tokens[1]});
-    } else {
-        return std::vector<std::string>(tokens.begin() + 2, tokens.end());
-    }
+
+std::string getReturnCodeString(ImplyReturnType aReturnType){
+    return returnCodeNames.find(aReturnType)->second;
 }
 
 
-// Scans input file and takes the count of each wire
-std::unordered_map<std::string, std::vector<std::string>> Circuit::get_wire_cnt(std::ifstream& file) {
-    // Initializes map
-    std::unordered_map<std::string, std::vector<std::string>> wire_cnt;
+std::string getGateTypeString(GateType aGateType){
+    return gateTypeNames.find(aGateType)->second;
+}
+
 
-    // Parses file line by line
-    std::string line;
-    while (std::getline(file, line)) {
-        // Skips line if its a comment or end-of-file or empty
-        if (line.starts_with('#') || line.starts_with('$') || string_is_whitespace(line)) {
+// Matches an ISCAS gate type token (either case) to its enum value
+bool getGateType(std::string_view aGateTypeString, GateType& aGateType){
+    for (auto& [myGateType, myGateTypeName] : gateTypeNames) {
+        if (aGateTypeString.size() != myGateTypeName.size()) {
             continue;
         }
+        if (std::equal(aGateTypeString.begin(), aGateTypeString.end(), myGateTypeName.begin(), [](char a, char b) { return std::toupper(a) == b; })) {
+            aGateType = myGateType;
+            return true;
+        }
+    }
+    return false;
+}
 
-        // Gets the name of each wire
-        std::vector<std::string> wire_names = get_wire_names(line);
-        std::string myOutputWireName = tokenize_line(line)[0];
 
-        // Sets value of each wire
-        for (auto wire_name : wire_names) {
-            if (line.starts_with("INPUT") || line.starts_with("input")) {
-                theCircuitInputs.push_back(wire_name);
-            } else if (line.starts_with("OUTPUT") || line.starts_with("output")) {
-                theCircuitOutputs.push_back(wire_name);
-            } else {
-                if (wire_cnt.contains(wire_name)) {
-                    wire_cnt[wire_name].push_back(myOutputWireName);
-                } else {
-                    wire_cnt[wire_name] = std::vector<std::string>({ myOutputWireName });
-                }
+// Maps a whole file read-only; an empty file maps to an empty range
+MappedFile::MappedFile(const std::string& aFileString) : theData(nullptr), theSize(0), theIsOpen(false) {
+    int myFd = open(aFileString.c_str(), O_RDONLY);
+    if (myFd < 0) {
+        return;
+    }
+    struct stat myStat;
+    if (fstat(myFd, &myStat) == 0) {
+        theSize = myStat.st_size;
+        if (theSize == 0) {
+            theIsOpen = true;
+        } else {
+            void* myData = mmap(nullptr, theSize, PROT_READ, MAP_PRIVATE, myFd, 0);
+            if (myData != MAP_FAILED) {
+                theData = static_cast<const char*>(myData);
+                theIsOpen = true;
             }
         }
     }
+    close(myFd);
+}
 
-    return wire_cnt;
+
+MappedFile::~MappedFile() {
+    if (theData != nullptr) {
+        munmap(const_cast<char*>(theData), theSize);
+    }
 }
 
 
-std::string getSignalStateString(SignalType aSignal){
-    return signalTypeNames.find(aSignal)->second;
+// Returns the ID of a wire, giving it the next ID on first sight
+int ParsedNetlist::internWire(std::string_view aWireName) {
+    auto [myWireIter, myInserted] = wireIds.try_emplace(aWireName, wireNames.size());
+    if (myInserted) {
+        wireNames.push_back(aWireName);
+    }
+    return myWireIter->second;
 }
 
 
-std::string getReturnCodeString(ImplyReturnType aReturnType){
-    return returnCodeNames.find(aReturnType)->second;
+// Closes the gate driving anOutputWire; its fanins are whatever was appended to gateFanins since the last gate
+void ParsedNetlist::addGate(int anOutputWire, GateType aGateType) {
+    gateOutputs.push_back(anOutputWire);
+    gateTypes.push_back(aGateType);
+    gateFaninOffsets.push_back(gateFanins.size());
+}
+
+
+// Separators in an ISCAS line - brackets, commas and equals signs are treated like whitespace
+static inline bool is_bench_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '(' || c == ')' || c == ',' || c == '=';
 }
 
 
-// Parses circuit from input file and populates data structures
-void Circuit::populate_circuit(std::ifstream& aCircuitFile, std::unordered_map<std::string, std::vector<std::string>> aWireCnt) {
-    std::string myLine;
-    while (std::getline(aCircuitFile, myLine)) {
+// Splits one ISCAS line into views of its tokens, without copying
+static void tokenize_bench_line(const char* aBegin, const char* anEnd, std::vector<std::string_view>& aTokens) {
+    aTokens.clear();
+    const char* myChar = aBegin;
+    while (myChar != anEnd) {
+        while (myChar != anEnd && is_bench_separator(*myChar)) {
+            myChar++;
+        }
+        const char* myTokenBegin = myChar;
+        while (myChar != anEnd && !is_bench_separator(*myChar)) {
+            myChar++;
+        }
+        if (myChar != myTokenBegin) {
+            aTokens.emplace_back(myTokenBegin, myChar - myTokenBegin);
+        }
+    }
+}
+
+
+// Parses ISCAS .bench text in a single pass, recording gates against interned wire IDs
+void CircuitTopology::parse_bench(const char* aBegin, const char* anEnd, ParsedNetlist& aNetlist) {
+    std::vector<std::string_view> myTokens;
+    myTokens.reserve(16);
+
+    const char* myLine = aBegin;
+    while (myLine < anEnd) {
+        const char* myLineEnd = static_cast<const char*>(std::memchr(myLine, '\n', anEnd - myLine));
+        if (myLineEnd == nullptr) {
+            myLineEnd = anEnd;
+        }
+
         // Skips line if its a comment or end-of-file or empty
-        if (myLine.starts_with('#') || myLine.starts_with('$') || string_is_whitespace(myLine)) {
+        tokenize_bench_line(myLine, myLineEnd, myTokens);
+        const char* myFirstChar = myTokens.empty() ? myLineEnd : myTokens[0].data();
+        myLine = myLineEnd + 1;
+        if (myTokens.empty() || *myFirstChar == '#' || *myFirstChar == '$') {
             continue;
         }
 
-        auto myInputWireNames = get_wire_names(myLine);
+        if (myTokens[0] == "INPUT" || myTokens[0] == "input") {
+            int myInputWire = aNetlist.internWire(myTokens[1]);
+            aNetlist.circuitInputs.push_back(myInputWire);
+            aNetlist.addGate(myInputWire, GateType::INPUT);
+        } else if (myTokens[0] == "OUTPUT" || myTokens[0] == "output") {
+            aNetlist.circuitOutputs.push_back(aNetlist.internWire(myTokens[1]));
+        } else {
+            if (myTokens.size() < 2) {
+                std::cout << "Error: Unable to parse line " << std::string_view(myFirstChar, myLineEnd - myFirstChar) << std::endl;
+                continue;
+            }
+            // Full scan - a flip-flop is cut into a pseudo-primary input (Q) and output (D)
+            if (myTokens[1] == "DFF" || myTokens[1] == "dff") {
+                if (myTokens.size() != 3) {
+                    std::cout << "Error: Flip-flop " << myTokens[0] << " must have exactly one input" << std::endl;
+                    continue;
+                }
+                int myStateWire = aNetlist.internWire(myTokens[0]);
+                aNetlist.scanCells.emplace_back(myStateWire, aNetlist.internWire(myTokens[2]));
+                aNetlist.addGate(myStateWire, GateType::INPUT);
+                continue;
+            }
+            GateType myGateType = GateType::BUFF;
+            if (!getGateType(myTokens[1], myGateType)) {
+                std::cout << "Error: Unable to match gate " << myTokens[1] << std::endl;
+            }
+            int myOutputWire = aNetlist.internWire(myTokens[0]);
+            for (std::size_t myTokenIdx = 2; myTokenIdx < myTokens.size(); myTokenIdx++) {
+                aNetlist.gateFanins.push_back(aNetlist.internWire(myTokens[myTokenIdx]));
+            }
+            aNetlist.addGate(myOutputWire, myGateType);
+        }
+    }
+}
 
-        if (!myLine.starts_with("OUTPUT") && !myLine.starts_with("output")) {
 
-            std::vector<std::string> myTokens = tokenize_line(myLine);
-            std::string myGateOutputWire;
-            std::string myGateType;
+// Streaming tokenizer for flat structural Verilog - identifiers come back as views into the source text
+class VerilogLexer {
+public:
+    VerilogLexer(const char* aBegin, const char* anEnd) : theChar(aBegin), theEnd(anEnd) {}
 
-            // Process circuit input
-            if (myLine.starts_with("INPUT") || myLine.starts_with("input")) {
-                myGateType = "INPUT";
-                myGateOutputWire = myTokens[1];
+    // Returns the next token, or an empty view at end of input
+    std::string_view next() {
+        skip_whitespace_and_comments();
+        if (theChar == theEnd) {
+            return std::string_view();
+        }
+        const char* myTokenBegin = theChar;
+        if (*theChar == '\\') {
+            // Escaped identifier - everything up to the next whitespace, without the backslash
+            myTokenBegin = ++theChar;
+            while (theChar != theEnd && !std::isspace(static_cast<unsigned char>(*theChar))) {
+                theChar++;
+            }
+        } else if (std::isalnum(static_cast<unsigned char>(*theChar)) || *theChar == '_' || *theChar == '$') {
+            while (theChar != theEnd && (std::isalnum(static_cast<unsigned char>(*theChar)) || *theChar == '_' || *theChar == '$' || *theChar == '\'')) {
+                theChar++;
+            }
+        } else {
+            theChar++;
+        }
+        return std::string_view(myTokenBegin, theChar - myTokenBegin);
+    }
+
+    // Skips ahead to just past the next ';'
+    void skip_statement() {
+        for (std::string_view myToken = next(); !myToken.empty() && myToken != ";"; myToken = next()) {
+        }
+    }
+
+private:
+    const char* theChar;
+    const char* theEnd;
+
+    void skip_whitespace_and_comments() {
+        while (theChar != theEnd) {
+            if (std::isspace(static_cast<unsigned char>(*theChar))) {
+                theChar++;
+            } else if (*theChar == '/' && theChar + 1 != theEnd && theChar[1] == '/') {
+                const char* myLineEnd = static_cast<const char*>(std::memchr(theChar, '\n', theEnd - theChar));
+                theChar = (myLineEnd == nullptr) ? theEnd : myLineEnd;
+            } else if (*theChar == '/' && theChar + 1 != theEnd && theChar[1] == '*') {
+                theChar += 2;
+                while (theChar != theEnd && !(*theChar == '*' && theChar + 1 != theEnd && theChar[1] == '/')) {
+                    theChar++;
+                }
+                theChar = (theChar == theEnd) ? theEnd : theChar + 2;
             } else {
-                myGateType = myTokens[1];
-                myGateOutputWire = myTokens[0];
+                return;
             }
+        }
+    }
+};
+
+
+// Matches a Verilog gate primitive to its enum value
+static bool get_verilog_gate_type(std::string_view aPrimitive, GateType& aGateType) {
+    if (aPrimitive == "and") { aGateType = GateType::AND; }
+    else if (aPrimitive == "nand") { aGateType = GateType::NAND; }
+    else if (aPrimitive == "or") { aGateType = GateType::OR; }
+    else if (aPrimitive == "nor") { aGateType = GateType::NOR; }
+    else if (aPrimitive == "xor") { aGateType = GateType::XOR; }
+    else if (aPrimitive == "xnor") { aGateType = GateType::XNOR; }
+    else if (aPrimitive == "not") { aGateType = GateType::NOT; }
+    else if (aPrimitive == "buf") { aGateType = GateType::BUFF; }
+    else { return false; }
+    return true;
+}
+
 
-            // std::cout << "Processing: " << myLine << " | " << myGateOutputWire << std::endl;
-
-            Gate myGate = {myGateType, std::vector<std::string>(), std::vector<std::string>()};
-
-            // Process regular gate
-            if (!myLine.starts_with("INPUT") && !myLine.starts_with("input")) {
-                for (auto& myInputWire : myInputWireNames) {
-                    if (aWireCnt[myInputWire].size() > 1) {
-                        // Input is a branch
-                        std::size_t myBranchIter = 0;
-                        std::string myInputWireBranch = myInputWire + "_BRANCH" + std::to_string(myBranchIter) + "_" + myGateOutputWire;
-                        while (std::ranges::find(myGate.inputs, myInputWireBranch) != myGate.inputs.end()){
-                            myBranchIter++;
-                            myInputWireBranch = myInputWire + "_BRANCH" + std::to_string(myBranchIter) + "_" + myGateOutputWire;
-                        }
-                        myGate.inputs.push_back(myInputWireBranch);
-                    } else {
-                        myGate.inputs.push_back(myInputWire);
+// Parses one flat structural Verilog module in a single pass, recording gates against interned wire IDs
+// Supports input/output/inout/wire declarations (ANSI or not), gate primitives with optional instance
+// names, and plain "assign a = b;" buffers. Ports declared inout become both circuit inputs and outputs.
+void CircuitTopology::parse_verilog(const char* aBegin, const char* anEnd, ParsedNetlist& aNetlist) {
+    VerilogLexer myLexer = VerilogLexer(aBegin, anEnd);
+    std::vector<std::string_view> myTerminals;
+    myTerminals.reserve(16);
+    std::vector<std::uint8_t> myDeclaredPorts;
+
+    // Declares a port wire; repeated declarations (ANSI header and body) only count once
+    auto declarePort = [&](std::string_view aWireName, bool anIsInput, bool anIsOutput) {
+        int myWire = aNetlist.internWire(aWireName);
+        if (myDeclaredPorts.size() <= static_cast<std::size_t>(myWire)) {
+            myDeclaredPorts.resize(aNetlist.wireNames.size(), 0);
+        }
+        if (anIsInput && !(myDeclaredPorts[myWire] & 1)) {
+            aNetlist.circuitInputs.push_back(myWire);
+            aNetlist.addGate(myWire, GateType::INPUT);
+        }
+        if (anIsOutput && !(myDeclaredPorts[myWire] & 2)) {
+            aNetlist.circuitOutputs.push_back(myWire);
+        }
+        myDeclaredPorts[myWire] |= (anIsInput ? 1 : 0) | (anIsOutput ? 2 : 0);
+    };
+
+    // Reads a comma separated declaration list up to aTerminator, switching direction on ANSI port keywords
+    auto parseDeclarations = [&](std::string_view aDirection, std::string_view aTerminator) {
+        for (std::string_view myToken = myLexer.next(); !myToken.empty() && myToken != aTerminator; myToken = myLexer.next()) {
+            if (myToken == "input" || myToken == "output" || myToken == "inout" || myToken == "wire") {
+                aDirection = myToken;
+            } else if (myToken == "[") {
+                std::cout << "Error: Verilog bus declarations are not supported" << std::endl;
+                for (; !myToken.empty() && myToken != "]"; myToken = myLexer.next()) {
+                }
+            } else if (myToken != "," && myToken != "reg") {
+                if (aDirection == "wire") {
+                    aNetlist.internWire(myToken);
+                } else if (!aDirection.empty()) {
+                    declarePort(myToken, aDirection != "output", aDirection != "input");
+                }
+            }
+        }
+    };
+
+    for (std::string_view myToken = myLexer.next(); !myToken.empty(); myToken = myLexer.next()) {
+        GateType myGateType;
+        if (myToken == "module") {
+            myLexer.next();
+            myToken = myLexer.next();
+            if (myToken == "(") {
+                parseDeclarations(std::string_view(), ")");
+            }
+            myLexer.skip_statement();
+        } else if (myToken == "input" || myToken == "output" || myToken == "inout" || myToken == "wire") {
+            parseDeclarations(myToken, ";");
+        } else if (myToken == "assign") {
+            std::string_view myOutput = myLexer.next();
+            std::string_view myEquals = myLexer.next();
+            std::string_view myInput = myLexer.next();
+            if (myEquals != "=" || myLexer.next() != ";") {
+                std::cout << "Error: Only simple \"assign a = b;\" statements are supported, at " << myOutput << std::endl;
+                myLexer.skip_statement();
+                continue;
+            }
+            int myOutputWire = aNetlist.internWire(myOutput);
+            aNetlist.gateFanins.push_back(aNetlist.internWire(myInput));
+            aNetlist.addGate(myOutputWire, GateType::BUFF);
+        } else if (get_verilog_gate_type(myToken, myGateType)) {
+            // One or more instances: [name] ( out, in, ... ) separated by commas
+            do {
+                myToken = myLexer.next();
+                if (myToken != "(") {
+                    myToken = myLexer.next();
+                }
+                if (myToken != "(") {
+                    std::cout << "Error: Expected terminal list after gate primitive, found " << myToken << std::endl;
+                    break;
+                }
+                myTerminals.clear();
+                for (myToken = myLexer.next(); !myToken.empty() && myToken != ")"; myToken = myLexer.next()) {
+                    if (myToken != ",") {
+                        myTerminals.push_back(myToken);
+                    }
+                }
+                if (myTerminals.size() < 2) {
+                    std::cout << "Error: Gate primitive needs an output and at least one input" << std::endl;
+                } else if (myGateType == GateType::BUFF || myGateType == GateType::NOT) {
+                    // buf/not drive every terminal but the last from the last one
+                    int myInputWire = aNetlist.internWire(myTerminals.back());
+                    for (std::size_t myTerminalIdx = 0; myTerminalIdx + 1 < myTerminals.size(); myTerminalIdx++) {
+                        int myOutputWire = aNetlist.internWire(myTerminals[myTerminalIdx]);
+                        aNetlist.gateFanins.push_back(myInputWire);
+                        aNetlist.addGate(myOutputWire, myGateType);
+                    }
+                } else {
+                    int myOutputWire = aNetlist.internWire(myTerminals[0]);
+                    for (std::size_t myTerminalIdx = 1; myTerminalIdx < myTerminals.size(); myTerminalIdx++) {
+                        aNetlist.gateFanins.push_back(aNetlist.internWire(myTerminals[myTerminalIdx]));
                     }
+                    aNetlist.addGate(myOutputWire, myGateType);
                 }
+                myToken = myLexer.next();
+            } while (myToken == ",");
+            if (myToken != ";") {
+                myLexer.skip_statement();
             }
+        } else if (myToken == "endmodule") {
+            break;
+        } else {
+            std::cout << "Error: Unsupported Verilog statement starting with " << myToken << std::endl;
+            myLexer.skip_statement();
+        }
+    }
+}
 
-            // Add additional gates if output is a stem to a branch
-            if (aWireCnt[myGateOutputWire].size() > 1) {
-                for (auto& myOutputBranch : aWireCnt[myGateOutputWire]) {
-                    std::size_t myBranchIter = 0;
-                    std::string myOutputBranchName = myGateOutputWire + "_BRANCH" + std::to_string(myBranchIter) + "_" + myOutputBranch;
-                    while (std::ranges::find(myGate.outputs, myOutputBranchName) != myGate.outputs.end()){
-                        myBranchIter++;
-                        myOutputBranchName = myGateOutputWire + "_BRANCH" + std::to_string(myBranchIter) + "_" + myOutputBranch;
-                    }
-                    myGate.outputs.push_back(myOutputBranchName);
-                    Gate myBranchGate = {"BUFF", std::vector<std::string>({myGateOutputWire}), std::vector<std::string>({myOutputBranch})};
-                    theCircuit[myOutputBranchName] = myBranchGate;
-                    theCircuitState[myOutputBranchName] = SignalType::X;
-                    theCircuitSignals.push_back(myOutputBranchName);
+
+// Expands fanout branches, assigns signal IDs and flattens the parsed gates into CSR fanin/fanout arrays
+// A wire read by more than one gate input becomes a stem, with one BUFF branch signal per read named
+// STEM_BRANCH<k>_<reader>; k counts repeated reads by the same gate. Branches take the IDs just before their stem.
+void CircuitTopology::compile_circuit(const ParsedNetlist& aNetlist) {
+    const int myNumWires = aNetlist.wireNames.size();
+    const int myNumGates = aNetlist.gateOutputs.size();
+    const int myNumReads = aNetlist.gateFanins.size();
+
+    // Gate driving each wire, and the gate performing each read
+    std::vector<int> myWireGates = std::vector<int>(myNumWires, -1);
+    std::vector<int> myReadGates = std::vector<int>(myNumReads);
+    for (int myGate = 0; myGate < myNumGates; myGate++) {
+        int myWire = aNetlist.gateOutputs[myGate];
+        if (myWireGates[myWire] >= 0) {
+            std::cout << "Error: Signal " << aNetlist.wireNames[myWire] << " is driven more than once" << std::endl;
+            continue;
+        }
+        myWireGates[myWire] = myGate;
+        for (int myRead = aNetlist.gateFaninOffsets[myGate]; myRead < aNetlist.gateFaninOffsets[myGate + 1]; myRead++) {
+            myReadGates[myRead] = myGate;
+        }
+    }
+
+    // Reads of each wire in file order (counting sort keeps it stable)
+    std::vector<int> myReaderOffsets = std::vector<int>(myNumWires + 1, 0);
+    for (int myWire : aNetlist.gateFanins) {
+        myReaderOffsets[myWire + 1]++;
+    }
+    for (int myWire = 0; myWire < myNumWires; myWire++) {
+        myReaderOffsets[myWire + 1] += myReaderOffsets[myWire];
+    }
+    std::vector<int> myReaders = std::vector<int>(myNumReads);
+    std::vector<int> myReaderFill = std::vector<int>(myReaderOffsets.begin(), myReaderOffsets.end() - 1);
+    for (int myRead = 0; myRead < myNumReads; myRead++) {
+        myReaders[myReaderFill[aNetlist.gateFanins[myRead]]++] = myRead;
+    }
+    auto isStem = [&](int aWire) { return myReaderOffsets[aWire + 1] - myReaderOffsets[aWire] > 1; };
+
+    // Assign signal IDs - branches of a stem, then the stem itself, in gate order
+    std::vector<int> myWireSignals = std::vector<int>(myNumWires, -1);
+    std::vector<int> myReadSignals = std::vector<int>(myNumReads, -1);
+    theSignalNames.reserve(myNumGates + myNumReads);
+    theGateTypes.reserve(myNumGates + myNumReads);
+    for (int myGate = 0; myGate < myNumGates; myGate++) {
+        int myWire = aNetlist.gateOutputs[myGate];
+        if (myWireGates[myWire] != myGate) {
+            continue;
+        }
+        if (isStem(myWire)) {
+            std::string myBranchPrefix = std::string(aNetlist.wireNames[myWire]) + "_BRANCH";
+            int myBranchIter = 0;
+            for (int myReaderIdx = myReaderOffsets[myWire]; myReaderIdx < myReaderOffsets[myWire + 1]; myReaderIdx++) {
+                int myRead = myReaders[myReaderIdx];
+                bool myRepeatedReader = myReaderIdx > myReaderOffsets[myWire] && myReadGates[myReaders[myReaderIdx - 1]] == myReadGates[myRead];
+                myBranchIter = myRepeatedReader ? myBranchIter + 1 : 0;
+
+                myReadSignals[myRead] = theSignalNames.size();
+                std::string_view myReaderName = aNetlist.wireNames[aNetlist.gateOutputs[myReadGates[myRead]]];
+                std::string myBranchName = myBranchPrefix;
+                myBranchName.reserve(myBranchPrefix.size() + myReaderName.size() + 4);
+                myBranchName.append(std::to_string(myBranchIter)).append("_").append(myReaderName);
+                theSignalNames.push_back(std::move(myBranchName));
+                theGateTypes.push_back(GateType::BUFF);
+            }
+        }
+        myWireSignals[myWire] = theSignalNames.size();
+        theSignalNames.emplace_back(aNetlist.wireNames[myWire]);
+        theGateTypes.push_back(aNetlist.gateTypes[myGate]);
+    }
+
+    const int myNumSignals = theSignalNames.size();
+
+    // Build CSR arrays, visiting signals in the same order the IDs were handed out
+    theFaninOffsets = std::vector<int>(myNumSignals + 1, 0);
+    theFanoutOffsets = std::vector<int>(myNumSignals + 1, 0);
+    theIsOutput = std::vector<std::uint8_t>(myNumSignals, 0);
+    theFanins.reserve(2 * myNumReads);
+    theFanouts.reserve(2 * myNumReads);
+    for (int myGate = 0; myGate < myNumGates; myGate++) {
+        int myWire = aNetlist.gateOutputs[myGate];
+        if (myWireGates[myWire] != myGate) {
+            continue;
+        }
+        const bool myIsStem = isStem(myWire);
+        if (myIsStem) {
+            for (int myReaderIdx = myReaderOffsets[myWire]; myReaderIdx < myReaderOffsets[myWire + 1]; myReaderIdx++) {
+                int myRead = myReaders[myReaderIdx];
+                theFanins.push_back(myWireSignals[myWire]);
+                theFanouts.push_back(myWireSignals[aNetlist.gateOutputs[myReadGates[myRead]]]);
+                theFaninOffsets[myReadSignals[myRead] + 1] = theFanins.size();
+                theFanoutOffsets[myReadSignals[myRead] + 1] = theFanouts.size();
+            }
+        }
+
+        for (int myRead = aNetlist.gateFaninOffsets[myGate]; myRead < aNetlist.gateFaninOffsets[myGate + 1]; myRead++) {
+            int myInputWire = aNetlist.gateFanins[myRead];
+            if (myWireGates[myInputWire] < 0) {
+                std::cout << "Error: Gate " << aNetlist.wireNames[myWire] << " reads undefined signal " << aNetlist.wireNames[myInputWire] << std::endl;
+                continue;
+            }
+            theFanins.push_back(isStem(myInputWire) ? myReadSignals[myRead] : myWireSignals[myInputWire]);
+        }
+        for (int myReaderIdx = myReaderOffsets[myWire]; myReaderIdx < myReaderOffsets[myWire + 1]; myReaderIdx++) {
+            int myRead = myReaders[myReaderIdx];
+            theFanouts.push_back(myIsStem ? myReadSignals[myRead] : myWireSignals[aNetlist.gateOutputs[myReadGates[myRead]]]);
+        }
+        theFaninOffsets[myWireSignals[myWire] + 1] = theFanins.size();
+        theFanoutOffsets[myWireSignals[myWire] + 1] = theFanouts.size();
+    }
+
+    for (int myInputWire : aNetlist.circuitInputs) {
+        theCircuitInputs.push_back(myWireSignals[myInputWire]);
+    }
+    for (int myOutputWire : aNetlist.circuitOutputs) {
+        int myOutputId = myWireSignals[myOutputWire];
+        if (myOutputId < 0) {
+            std::cout << "Error: Circuit output " << aNetlist.wireNames[myOutputWire] << " is never driven" << std::endl;
+            continue;
+        }
+        theCircuitOutputs.push_back(myOutputId);
+        theIsOutput[myOutputId] = 1;
+    }
+
+    // Scan cells go after the real inputs/outputs; an undriven D would break the pairing, so that cell is dropped
+    theNumScanCells = 0;
+    for (auto& [myStateWire, myNextStateWire] : aNetlist.scanCells) {
+        int myNextStateId = myWireSignals[myNextStateWire];
+        if (myNextStateId < 0) {
+            std::cout << "Error: Flip-flop " << aNetlist.wireNames[myStateWire] << " reads undefined signal " << aNetlist.wireNames[myNextStateWire] << std::endl;
+            continue;
+        }
+        theCircuitInputs.push_back(myWireSignals[myStateWire]);
+        theCircuitOutputs.push_back(myNextStateId);
+        theIsOutput[myNextStateId] = 1;
+        theNumScanCells++;
+    }
+}
+
+
+// Assigns each signal a level with Kahn's algorithm so implication can sweep the circuit in topological order
+void CircuitTopology::levelize_circuit() {
+    const int myNumSignals = getNumSignals();
+
+    theLevels = std::vector<int>(myNumSignals, 0);
+    theMaxLevel = 0;
+
+    std::vector<int> myPendingFanins = std::vector<int>(myNumSignals);
+    theTopologicalOrder = std::vector<int>();
+    theTopologicalOrder.reserve(myNumSignals);
+    for (int mySignal = 0; mySignal < myNumSignals; mySignal++) {
+        myPendingFanins[mySignal] = faninEnd(mySignal) - faninBegin(mySignal);
+        if (myPendingFanins[mySignal] == 0) {
+            theTopologicalOrder.push_back(mySignal);
+        }
+    }
+
+    for (std::size_t myReadyIdx = 0; myReadyIdx < theTopologicalOrder.size(); myReadyIdx++) {
+        int mySignal = theTopologicalOrder[myReadyIdx];
+        for (const int* myFanout = fanoutBegin(mySignal); myFanout != fanoutEnd(mySignal); myFanout++) {
+            theLevels[*myFanout] = std::max(theLevels[*myFanout], theLevels[mySignal] + 1);
+            if (--myPendingFanins[*myFanout] == 0) {
+                theTopologicalOrder.push_back(*myFanout);
+            }
+        }
+        theMaxLevel = std::max(theMaxLevel, theLevels[mySignal]);
+    }
+
+    if (theTopologicalOrder.size() != static_cast<std::size_t>(myNumSignals)) {
+        std::cout << "Error: Circuit contains a combinational loop, " << (myNumSignals - theTopologicalOrder.size()) << " signals could not be levelized" << std::endl;
+    }
+}
+
+
+static inline int scoap_add(int a, int b) {
+    return std::min(a + b, SCOAP_INFINITY);
+}
+
+
+// Computes SCOAP controllability in topological order, then observability in reverse topological order
+void CircuitTopology::compute_testability() {
+    const int myNumSignals = getNumSignals();
+
+    theCC0 = std::vector<int>(myNumSignals, SCOAP_INFINITY);
+    theCC1 = std::vector<int>(myNumSignals, SCOAP_INFINITY);
+    theCO = std::vector<int>(myNumSignals, SCOAP_INFINITY);
+
+    for (int mySignal : theTopologicalOrder) {
+        const int* myFanins = faninBegin(mySignal);
+        const std::size_t myNumFanins = faninEnd(mySignal) - myFanins;
+        GateType myGateType = theGateTypes[mySignal];
+
+        if (myGateType == GateType::INPUT || myNumFanins == 0) {
+            theCC0[mySignal] = 1;
+            theCC1[mySignal] = 1;
+            continue;
+        }
+
+        int myCC0 = theCC0[myFanins[0]];
+        int myCC1 = theCC1[myFanins[0]];
+        for (std::size_t myFaninIter = 1; myFaninIter < myNumFanins; myFaninIter++) {
+            int myFaninCC0 = theCC0[myFanins[myFaninIter]];
+            int myFaninCC1 = theCC1[myFanins[myFaninIter]];
+            switch (myGateType) {
+            case GateType::AND:
+            case GateType::NAND:
+                myCC0 = std::min(myCC0, myFaninCC0);
+                myCC1 = scoap_add(myCC1, myFaninCC1);
+                break;
+            case GateType::OR:
+            case GateType::NOR:
+                myCC0 = scoap_add(myCC0, myFaninCC0);
+                myCC1 = std::min(myCC1, myFaninCC1);
+                break;
+            case GateType::XOR:
+            case GateType::XNOR: {
+                int myNextCC0 = std::min(scoap_add(myCC0, myFaninCC0), scoap_add(myCC1, myFaninCC1));
+                int myNextCC1 = std::min(scoap_add(myCC0, myFaninCC1), scoap_add(myCC1, myFaninCC0));
+                myCC0 = myNextCC0;
+                myCC1 = myNextCC1;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        bool myInverting = myGateType == GateType::NAND || myGateType == GateType::NOR || myGateType == GateType::XNOR || myGateType == GateType::NOT;
+        theCC0[mySignal] = scoap_add(myInverting ? myCC1 : myCC0, 1);
+        theCC1[mySignal] = scoap_add(myInverting ? myCC0 : myCC1, 1);
+    }
+
+    for (int myOutput : theCircuitOutputs) {
+        theCO[myOutput] = 0;
+    }
+
+    // Observability of a fanin through a gate = gate observability + cost of setting every other input non-controlling
+    for (auto mySignalIter = theTopologicalOrder.rbegin(); mySignalIter != theTopologicalOrder.rend(); mySignalIter++) {
+        int mySignal = *mySignalIter;
+        if (theCO[mySignal] >= SCOAP_INFINITY) {
+            continue;
+        }
+        const int* myFanins = faninBegin(mySignal);
+        const std::size_t myNumFanins = faninEnd(mySignal) - myFanins;
+        for (std::size_t myFaninIter = 0; myFaninIter < myNumFanins; myFaninIter++) {
+            int myFaninCO = scoap_add(theCO[mySignal], 1);
+            for (std::size_t mySideIter = 0; mySideIter < myNumFanins; mySideIter++) {
+                if (mySideIter == myFaninIter) {
+                    continue;
                 }
-            } else {
-                for (auto& myOutputBranch : aWireCnt[myGateOutputWire]) {
-                    myGate.outputs.push_back(myOutputBranch);
+                int mySide = myFanins[mySideIter];
+                switch (theGateTypes[mySignal]) {
+                case GateType::AND:
+                case GateType::NAND:
+                    myFaninCO = scoap_add(myFaninCO, theCC1[mySide]);
+                    break;
+                case GateType::OR:
+                case GateType::NOR:
+                    myFaninCO = scoap_add(myFaninCO, theCC0[mySide]);
+                    break;
+                case GateType::XOR:
+                case GateType::XNOR:
+                    myFaninCO = scoap_add(myFaninCO, std::min(theCC0[mySide], theCC1[mySide]));
+                    break;
+                default:
+                    break;
                 }
             }
+            theCO[myFanins[myFaninIter]] = std::min(theCO[myFanins[myFaninIter]], myFaninCO);
+        }
+    }
+}
+
 
-            theCircuit[myGateOutputWire] = myGate;
-            theCircuitState[myGateOutputWire] = SignalType::X;
-            theCircuitSignals.push_back(myGateOutputWire);
+// Fills the open-addressed name table at twice the signal count, so probe chains stay short
+void CircuitTopology::build_signal_index() {
+    std::size_t myIndexSize = 1;
+    while (myIndexSize < 2 * theSignalNames.size()) {
+        myIndexSize <<= 1;
+    }
+    theSignalIndex = std::vector<int>(myIndexSize, -1);
+    for (std::size_t mySignal = 0; mySignal < theSignalNames.size(); mySignal++) {
+        std::size_t mySlot = hash_bytes(theSignalNames[mySignal].data(), theSignalNames[mySignal].size()) & (myIndexSize - 1);
+        while (theSignalIndex[mySlot] >= 0) {
+            mySlot = (mySlot + 1) & (myIndexSize - 1);
         }
+        theSignalIndex[mySlot] = mySignal;
     }
 }
 
 
-Circuit::Circuit() {};
+// Returns the ID of a named signal, or -1 if the signal does not exist
+int CircuitTopology::getSignalId(const std::string& aSignalName) const {
+    if (theSignalIndex.empty()) {
+        return -1;
+    }
+    const std::size_t myMask = theSignalIndex.size() - 1;
+    std::size_t mySlot = hash_bytes(aSignalName.data(), aSignalName.size()) & myMask;
+    while (theSignalIndex[mySlot] >= 0) {
+        if (theSignalNames[theSignalIndex[mySlot]] == aSignalName) {
+            return theSignalIndex[mySlot];
+        }
+        mySlot = (mySlot + 1) & myMask;
+    }
+    return -1;
+}
 
 
-// Upon construction, begin parsing and populate data structures
-Circuit::Circuit(const std::string aCircuitFileString) :
-        theFaultLocation(""),
-        theFaultValue(SignalType::X),
-        theCircuitFileString(aCircuitFileString) {
+// 64-bit FNV-1a, used for the cache content hash and the signal name table
+std::uint64_t hash_bytes(const char* aData, std::size_t aSize) {
+    std::uint64_t myHash = 14695981039346656037ULL;
+    for (std::size_t myByte = 0; myByte < aSize; myByte++) {
+        myHash ^= static_cast<unsigned char>(aData[myByte]);
+        myHash *= 1099511628211ULL;
+    }
+    return myHash;
+}
 
-    theCircuit = std::unordered_map<std::string, Gate>();
-    theCircuitState = std::unordered_map<std::string, SignalType>();
 
-    theCircuitInputs = std::vector<std::string>();
-    theCircuitOutputs = std::vector<std::string>();
-    theCircuitSignals = std::vector<std::string>();
+// Derives the flip-flop connectivity between time frames from the scan cells
+// Sequential depth is relaxed through the flip-flops until it settles, so it costs O(signals * depth)
+void CircuitTopology::build_frame_map() {
+    const int myNumSignals = getNumSignals();
 
-    theDFrontier = std::unordered_set<std::string>();
+    thePresentStateCells = std::vector<int>(myNumSignals, -1);
+    theNextStateOffsets = std::vector<int>(myNumSignals + 1, 0);
+    theNextStateCells = std::vector<int>(theNumScanCells);
+    for (int myCell = 0; myCell < theNumScanCells; myCell++) {
+        thePresentStateCells[getPresentState(myCell)] = myCell;
+        theNextStateOffsets[getNextState(myCell) + 1]++;
+    }
+    for (int mySignal = 0; mySignal < myNumSignals; mySignal++) {
+        theNextStateOffsets[mySignal + 1] += theNextStateOffsets[mySignal];
+    }
+    std::vector<int> myNextStateFill = std::vector<int>(theNextStateOffsets.begin(), theNextStateOffsets.end() - 1);
+    for (int myCell = 0; myCell < theNumScanCells; myCell++) {
+        theNextStateCells[myNextStateFill[getNextState(myCell)]++] = myCell;
+    }
 
-    theCircuitFile.open(theCircuitFileString);
+    theIsPrimaryOutput = std::vector<std::uint8_t>(myNumSignals, 0);
+    for (int myOutputIdx = 0; myOutputIdx < getNumPrimaryOutputs(); myOutputIdx++) {
+        theIsPrimaryOutput[theCircuitOutputs[myOutputIdx]] = 1;
+    }
+
+    theSequentialDepth = std::vector<int>(myNumSignals, SCOAP_INFINITY);
+    bool myDepthChanged = true;
+    while (myDepthChanged) {
+        myDepthChanged = false;
+        for (int mySignal : theTopologicalOrder) {
+            int myDepth = SCOAP_INFINITY;
+            if (theGateTypes[mySignal] == GateType::INPUT) {
+                int myCell = thePresentStateCells[mySignal];
+                myDepth = (myCell < 0) ? 0 : scoap_add(theSequentialDepth[getNextState(myCell)], 1);
+            } else {
+                for (const int* myFanin = faninBegin(mySignal); myFanin != faninEnd(mySignal); myFanin++) {
+                    myDepth = std::min(myDepth, theSequentialDepth[*myFanin]);
+                }
+            }
+            if (myDepth != theSequentialDepth[mySignal]) {
+                theSequentialDepth[mySignal] = myDepth;
+                myDepthChanged = true;
+            }
+        }
+    }
+}
+
+
+// Fixed header at the start of a netlist cache file; every array after it starts on an 8-byte boundary
+struct NetlistCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t sourceHash;
+    std::int32_t numSignals;
+    std::int32_t numFanins;
+    std::int32_t numFanouts;
+    std::int32_t numInputs;
+    std::int32_t numOutputs;
+    std::int32_t maxLevel;
+    std::int32_t numOrdered;
+    std::int32_t numScanCells;
+    std::uint64_t indexSize;
+    std::uint64_t nameBytes;
+};
+
+static const char NETLIST_CACHE_MAGIC[8] = {'P', 'O', 'D', 'E', 'M', 'N', 'L', 'C'};
+
+
+// Copies the next array out of a mapped cache file, advancing the cursor past its padding
+template <typename T>
+static bool read_cache_array(const char*& aCursor, const char* anEnd, std::vector<T>& anArray, std::size_t aCount) {
+    std::size_t myBytes = aCount * sizeof(T);
+    if (static_cast<std::size_t>(anEnd - aCursor) < myBytes) {
+        return false;
+    }
+    anArray.resize(aCount);
+    std::memcpy(anArray.data(), aCursor, myBytes);
+    aCursor += (myBytes + 7) & ~std::size_t(7);
+    return true;
+}
+
+
+template <typename T>
+static void write_cache_array(std::ofstream& aCacheFile, const std::vector<T>& anArray) {
+    static const char myPadding[8] = {};
+    std::size_t myBytes = anArray.size() * sizeof(T);
+    aCacheFile.write(reinterpret_cast<const char*>(anArray.data()), myBytes);
+    aCacheFile.write(myPadding, ((myBytes + 7) & ~std::size_t(7)) - myBytes);
+}
+
+
+// Loads the compiled netlist from a cache file; fails if the file is missing, stale or from another version
+bool CircuitTopology::load_cache(const std::string& aCacheFileString, std::uint64_t aSourceHash) {
+    MappedFile myCacheFile(aCacheFileString);
+    if (!myCacheFile.is_open() || myCacheFile.size() < sizeof(NetlistCacheHeader)) {
+        return false;
+    }
+
+    NetlistCacheHeader myHeader;
+    std::memcpy(&myHeader, myCacheFile.data(), sizeof(NetlistCacheHeader));
+    if (std::memcmp(myHeader.magic, NETLIST_CACHE_MAGIC, sizeof(NETLIST_CACHE_MAGIC)) != 0 ||
+        myHeader.version != NETLIST_CACHE_VERSION ||
+        myHeader.headerSize != sizeof(NetlistCacheHeader) ||
+        myHeader.sourceHash != aSourceHash) {
+        return false;
+    }
+
+    const char* myCursor = myCacheFile.data() + ((sizeof(NetlistCacheHeader) + 7) & ~std::size_t(7));
+    const char* myEnd = myCacheFile.data() + myCacheFile.size();
+    const std::size_t myNumSignals = myHeader.numSignals;
+
+    std::vector<std::uint64_t> myNameOffsets;
+    std::vector<char> myNames;
+    bool myIsValid = read_cache_array(myCursor, myEnd, theGateTypes, myNumSignals)
+                  && read_cache_array(myCursor, myEnd, theFaninOffsets, myNumSignals + 1)
+                  && read_cache_array(myCursor, myEnd, theFanins, myHeader.numFanins)
+                  && read_cache_array(myCursor, myEnd, theFanoutOffsets, myNumSignals + 1)
+                  && read_cache_array(myCursor, myEnd, theFanouts, myHeader.numFanouts)
+                  && read_cache_array(myCursor, myEnd, theIsOutput, myNumSignals)
+                  && read_cache_array(myCursor, myEnd, theLevels, myNumSignals)
+                  && read_cache_array(myCursor, myEnd, theTopologicalOrder, myHeader.numOrdered)
+                  && read_cache_array(myCursor, myEnd, theCircuitInputs, myHeader.numInputs)
+                  && read_cache_array(myCursor, myEnd, theCircuitOutputs, myHeader.numOutputs)
+                  && read_cache_array(myCursor, myEnd, theCC0, myNumSignals)
+                  && read_cache_array(myCursor, myEnd, theCC1, myNumSignals)
+                  && read_cache_array(myCursor, myEnd, theCO, myNumSignals)
+                  && read_cache_array(myCursor, myEnd, theSignalIndex, myHeader.indexSize)
+                  && read_cache_array(myCursor, myEnd, myNameOffsets, myNumSignals + 1)
+                  && read_cache_array(myCursor, myEnd, myNames, myHeader.nameBytes);
+    if (!myIsValid ||
+        theFaninOffsets.back() != myHeader.numFanins ||
+        theFanoutOffsets.back() != myHeader.numFanouts ||
+        myNameOffsets.back() != myHeader.nameBytes ||
+        (myHeader.indexSize & (myHeader.indexSize - 1)) != 0) {
+        // Leave nothing half-loaded behind for the parser to append to
+        theGateTypes.clear();
+        theFaninOffsets.clear();
+        theFanins.clear();
+        theFanoutOffsets.clear();
+        theFanouts.clear();
+        theIsOutput.clear();
+        theLevels.clear();
+        theTopologicalOrder.clear();
+        theCircuitInputs.clear();
+        theCircuitOutputs.clear();
+        theCC0.clear();
+        theCC1.clear();
+        theCO.clear();
+        theSignalIndex.clear();
+        return false;
+    }
 
-    if (!theCircuitFile.is_open()) {
+    theMaxLevel = myHeader.maxLevel;
+    theNumScanCells = myHeader.numScanCells;
+    theSignalNames = std::vector<std::string>();
+    theSignalNames.reserve(myNumSignals);
+    for (std::size_t mySignal = 0; mySignal < myNumSignals; mySignal++) {
+        theSignalNames.emplace_back(myNames.data() + myNameOffsets[mySignal], myNameOffsets[mySignal + 1] - myNameOffsets[mySignal]);
+    }
+    return true;
+}
+
+
+// Writes the compiled netlist to a cache file, going through a temporary file so readers never see a partial cache
+bool CircuitTopology::write_cache(const std::string& aCacheFileString, std::uint64_t aSourceHash) const {
+    std::string myTempFileString = aCacheFileString + ".tmp" + std::to_string(getpid());
+    std::ofstream myCacheFile(myTempFileString, std::ios::binary | std::ios::trunc);
+    if (!myCacheFile.is_open()) {
+        return false;
+    }
+
+    std::vector<std::uint64_t> myNameOffsets = std::vector<std::uint64_t>(1, 0);
+    std::vector<char> myNames;
+    for (auto& mySignalName : theSignalNames) {
+        myNames.insert(myNames.end(), mySignalName.begin(), mySignalName.end());
+        myNameOffsets.push_back(myNames.size());
+    }
+
+    NetlistCacheHeader myHeader = NetlistCacheHeader();
+    std::memcpy(myHeader.magic, NETLIST_CACHE_MAGIC, sizeof(NETLIST_CACHE_MAGIC));
+    myHeader.version = NETLIST_CACHE_VERSION;
+    myHeader.headerSize = sizeof(NetlistCacheHeader);
+    myHeader.sourceHash = aSourceHash;
+    myHeader.numSignals = getNumSignals();
+    myHeader.numFanins = theFanins.size();
+    myHeader.numFanouts = theFanouts.size();
+    myHeader.numInputs = theCircuitInputs.size();
+    myHeader.numOutputs = theCircuitOutputs.size();
+    myHeader.maxLevel = theMaxLevel;
+    myHeader.numOrdered = theTopologicalOrder.size();
+    myHeader.numScanCells = theNumScanCells;
+    myHeader.indexSize = theSignalIndex.size();
+    myHeader.nameBytes = myNames.size();
+
+    write_cache_array(myCacheFile, std::vector<NetlistCacheHeader>(1, myHeader));
+    write_cache_array(myCacheFile, theGateTypes);
+    write_cache_array(myCacheFile, theFaninOffsets);
+    write_cache_array(myCacheFile, theFanins);
+    write_cache_array(myCacheFile, theFanoutOffsets);
+    write_cache_array(myCacheFile, theFanouts);
+    write_cache_array(myCacheFile, theIsOutput);
+    write_cache_array(myCacheFile, theLevels);
+    write_cache_array(myCacheFile, theTopologicalOrder);
+    write_cache_array(myCacheFile, theCircuitInputs);
+    write_cache_array(myCacheFile, theCircuitOutputs);
+    write_cache_array(myCacheFile, theCC0);
+    write_cache_array(myCacheFile, theCC1);
+    write_cache_array(myCacheFile, theCO);
+    write_cache_array(myCacheFile, theSignalIndex);
+    write_cache_array(myCacheFile, myNameOffsets);
+    write_cache_array(myCacheFile, myNames);
+    myCacheFile.close();
+
+    if (!myCacheFile || std::rename(myTempFileString.c_str(), aCacheFileString.c_str()) != 0) {
+        std::remove(myTempFileString.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+// Upon construction, load the netlist cache if it matches the source file, otherwise parse and refresh the cache
+CircuitTopology::CircuitTopology(const std::string aCircuitFileString) :
+        theCircuitFileString(aCircuitFileString),
+        theMaxLevel(0),
+        theNumScanCells(0) {
+
+    auto myLoadStart = std::chrono::steady_clock::now();
+
+    MappedFile myCircuitFile(theCircuitFileString);
+
+    if (!myCircuitFile.is_open()) {
         std::cout << "Error opening file " << theCircuitFileString << std::endl;
         return;
     }
 
-    // First pass - determine any stem and branches for future reference
-    auto myWireCnt = get_wire_cnt(theCircuitFile);
+    const std::uint64_t mySourceHash = hash_bytes(myCircuitFile.data(), myCircuitFile.size());
+    const std::string myCacheFileString = theCircuitFileString + NETLIST_CACHE_EXTENSION;
 
-    theCircuitFile.clear();
-    theCircuitFile.seekg(0);
+    if (load_cache(myCacheFileString, mySourceHash)) {
+        double myLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - myLoadStart).count();
+        std::cout << "Info: Loaded " << myCacheFileString << " | " << getNumSignals() << " signals in " << std::fixed << std::setprecision(6) << myLoadTime << " s" << std::endl;
+        std::cout.unsetf(std::ios_base::floatfield);
+    } else {
+        // Single pass over the mapped text (.v as structural Verilog, anything else as ISCAS .bench)
+        // Gates reference interned wire IDs, names stay views into the file
+        ParsedNetlist myNetlist = ParsedNetlist();
+        myNetlist.wireIds.reserve(myCircuitFile.size() / 32);
+        if (theCircuitFileString.ends_with(".v")) {
+            parse_verilog(myCircuitFile.data(), myCircuitFile.data() + myCircuitFile.size(), myNetlist);
+        } else {
+            parse_bench(myCircuitFile.data(), myCircuitFile.data() + myCircuitFile.size(), myNetlist);
+        }
 
-    // Second pass - populate data structures
-    populate_circuit(theCircuitFile, myWireCnt);
+        // Expand fanout branches and build the integer-indexed netlist used during search
+        compile_circuit(myNetlist);
+        levelize_circuit();
+        compute_testability();
+        build_signal_index();
+
+        double myParseTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - myLoadStart).count();
+        double myFileMB = myCircuitFile.size() / (1024.0 * 1024.0);
+        std::cout << "Info: Parsed " << theCircuitFileString << " | " << std::fixed << std::setprecision(3) << myFileMB << " MB, "
+                  << myNetlist.gateOutputs.size() << " gates, " << getNumSignals() << " signals in " << std::setprecision(6) << myParseTime << " s | "
+                  << std::setprecision(1) << (myFileMB / myParseTime) << " MB/s, " << std::setprecision(0) << (myNetlist.gateOutputs.size() / myParseTime) << " gates/s" << std::endl;
+        std::cout.unsetf(std::ios_base::floatfield);
+
+        if (!write_cache(myCacheFileString, mySourceHash)) {
+            std::cout << "Info: Unable to write netlist cache " << myCacheFileString << std::endl;
+        }
+    }
+    build_frame_map();
+    std::cout << std::setprecision(6);
 
     #ifdef DEBUG
     std::cout << "\n\n----- Printing Populated Circuit -----" << std::endl;
+    printCircuit();
+    #endif
 
-    for (auto& [myWireName, myGate] : theCircuit){
-        std::cout << "\n--- Gate: " << myWireName << " | Type: " << myGate.gateType << " ---" << std::endl;
-        std::cout << "Inputs: ";
-        for (auto& myGateInput : myGate.inputs) {
-            std::cout << myGateInput << " ";
+}
+
+
+// Equivalence - a gate input line (a signal whose only fanout is the gate and which is not itself observed) stuck at
+// the controlling value is equivalent to the output stuck at the controlled value; buffers and inverters pass both faults
+// Dominance - the output stuck at the non-controlled value dominates such an input stuck at the non-controlling value
+FaultList::FaultList(const CircuitTopology& aTopology) :
+        theRepresentatives(2 * aTopology.getNumSignals()),
+        theDominated(2 * aTopology.getNumSignals(), -1),
+        theNumClasses(0),
+        theNumTargets(0) {
+
+    for (int myFaultIdx = 0; myFaultIdx < getNumFaults(); myFaultIdx++) {
+        theRepresentatives[myFaultIdx] = myFaultIdx;
+    }
+    auto find = [&](int aFaultIdx) {
+        while (theRepresentatives[aFaultIdx] != aFaultIdx) {
+            theRepresentatives[aFaultIdx] = theRepresentatives[theRepresentatives[aFaultIdx]];
+            aFaultIdx = theRepresentatives[aFaultIdx];
         }
-        std::cout << std::endl << "Outputs: ";
-        for (auto& myGateOutput : myGate.outputs) {
-            std::cout << myGateOutput + " ";
+        return aFaultIdx;
+    };
+    auto isInputLine = [&](int aSignal) {
+        return aTopology.fanoutEnd(aSignal) - aTopology.fanoutBegin(aSignal) == 1 && !aTopology.theIsOutput[aSignal];
+    };
+
+    for (int myGate = 0; myGate < aTopology.getNumSignals(); myGate++) {
+        GateType myGateType = aTopology.theGateTypes[myGate];
+        bool myInverting = myGateType == GateType::NOT || myGateType == GateType::NAND || myGateType == GateType::NOR;
+        for (const int* myFanin = aTopology.faninBegin(myGate); myFanin != aTopology.faninEnd(myGate); myFanin++) {
+            if (!isInputLine(*myFanin)) {
+                continue;
+            }
+            for (SignalType myInputFault : {SignalType::D, SignalType::D_b}) {
+                // Buffers and inverters pass both faults, AND/NAND stuck-at-0 and OR/NOR stuck-at-1 inputs force the output
+                bool myForcesOutput = myGateType == GateType::BUFF || myGateType == GateType::NOT
+                                   || ((myGateType == GateType::AND || myGateType == GateType::NAND) && myInputFault == SignalType::D)
+                                   || ((myGateType == GateType::OR || myGateType == GateType::NOR) && myInputFault == SignalType::D_b);
+                if (!myForcesOutput) {
+                    continue;
+                }
+                SignalType myOutputFault = myInverting ? ((myInputFault == SignalType::D) ? SignalType::D_b : SignalType::D) : myInputFault;
+                int myInputRoot = find(getFaultIdx(*myFanin, myInputFault));
+                int myOutputRoot = find(getFaultIdx(myGate, myOutputFault));
+                theRepresentatives[std::max(myInputRoot, myOutputRoot)] = std::min(myInputRoot, myOutputRoot);
+            }
         }
-        std::cout << std::endl;
     }
+    for (int myFaultIdx = 0; myFaultIdx < getNumFaults(); myFaultIdx++) {
+        theRepresentatives[myFaultIdx] = find(myFaultIdx);
+        theNumClasses += theRepresentatives[myFaultIdx] == myFaultIdx;
+    }
+
+    // Dominance is only followed to a class that does not lead back, so every chain ends at a targeted class
+    for (int myGate = 0; myGate < aTopology.getNumSignals(); myGate++) {
+        GateType myGateType = aTopology.theGateTypes[myGate];
+        if ((myGateType != GateType::AND && myGateType != GateType::NAND && myGateType != GateType::OR && myGateType != GateType::NOR)
+            || aTopology.faninEnd(myGate) - aTopology.faninBegin(myGate) < 2) {
+            continue;
+        }
+        SignalType myInputFault = (myGateType == GateType::AND || myGateType == GateType::NAND) ? SignalType::D_b : SignalType::D;
+        SignalType myOutputFault = (myGateType == GateType::NAND || myGateType == GateType::NOR) ? ((myInputFault == SignalType::D) ? SignalType::D_b : SignalType::D) : myInputFault;
+        int myDominating = theRepresentatives[getFaultIdx(myGate, myOutputFault)];
+        if (theDominated[myDominating] >= 0) {
+            continue;
+        }
+        for (const int* myFanin = aTopology.faninBegin(myGate); myFanin != aTopology.faninEnd(myGate); myFanin++) {
+            if (!isInputLine(*myFanin)) {
+                continue;
+            }
+            int myChainClass = theRepresentatives[getFaultIdx(*myFanin, myInputFault)];
+            int myDominatedClass = myChainClass;
+            while (myChainClass >= 0 && myChainClass != myDominating) {
+                myChainClass = theDominated[myChainClass];
+            }
+            if (myChainClass < 0) {
+                theDominated[myDominating] = myDominatedClass;
+                break;
+            }
+        }
+    }
+    for (int myFaultIdx = 0; myFaultIdx < getNumFaults(); myFaultIdx++) {
+        theNumTargets += isTarget(myFaultIdx);
+    }
+}
+
+
+Circuit::Circuit() :
+        theNumErrorOutputs(0),
+        theFaultLocation(-1),
+        theFaultValue(SignalType::X),
+        theNumBacktracks(0),
+        theNumFrames(1),
+        theNumFrameSignals(0),
+        theIsUnrolled(false),
+        theFaultFrameSignal(-1),
+        theObservedOutputs(nullptr),
+        theNumRequiredConflicts(0),
+        theXPathEpoch(0),
+        theCancelToken(nullptr),
+        theCancelEpoch(0) {}
 
+
+Circuit::Circuit(const std::string aCircuitFileString) :
+        Circuit(std::make_shared<const CircuitTopology>(aCircuitFileString)) {
+
+    #ifdef DEBUG
     printCircuitState();
     #endif
 
 }
 
-Circuit& Circuit::operator=(const Circuit& other) {
-    theCircuit = other.theCircuit;
-    theCircuitState = other.theCircuitState;
-    theCircuitInputs = other.theCircuitInputs;
-    theCircuitOutputs = other.theCircuitOutputs;
-    theCircuitSignals = other.theCircuitSignals;
-    theFaultLocation = other.theFaultLocation;
-    theFaultValue = other.theFaultValue;
-    theDFrontier = other.theDFrontier;
-    theCircuitFileString = other.theCircuitFileString;
-    return *this;
+
+// Full-scan circuit - flip-flops are controlled and observed through the scan chain
+Circuit::Circuit(std::shared_ptr<const CircuitTopology> aTopology) :
+        Circuit(aTopology, 1, false) {}
+
+
+// Sequential circuit unrolled over the given number of time frames
+Circuit::Circuit(std::shared_ptr<const CircuitTopology> aTopology, int aNumFrames) :
+        Circuit(aTopology, aNumFrames, true) {}
+
+
+// Search state is sized from the topology and frame count; copies of a Circuit share the topology and only duplicate this state
+Circuit::Circuit(std::shared_ptr<const CircuitTopology> aTopology, int aNumFrames, bool anIsUnrolled) :
+        theTopology(aTopology),
+        theNumErrorOutputs(0),
+        theFaultLocation(-1),
+        theFaultValue(SignalType::X),
+        theNumBacktracks(0),
+        theDFrontier(aNumFrames * aTopology->getNumSignals()),
+        theNumFrames(aNumFrames),
+        theNumFrameSignals(aTopology->getNumSignals()),
+        theIsUnrolled(anIsUnrolled),
+        theFaultFrameSignal(-1),
+        theObservedOutputs(anIsUnrolled ? &aTopology->theIsPrimaryOutput : &aTopology->theIsOutput),
+        theCircuitState(aNumFrames * aTopology->getNumSignals(), SignalType::X),
+        theRequiredStates(aNumFrames * aTopology->getNumSignals(), SignalType::X),
+        theNumRequiredConflicts(0),
+        theEventWheel(aNumFrames * (aTopology->theMaxLevel + 1)),
+        theScheduled(aNumFrames * aTopology->getNumSignals()),
+        theXPathStamps(aNumFrames * aTopology->getNumSignals(), 0),
+        theXPathEpoch(0),
+        theCancelToken(nullptr),
+        theCancelEpoch(0) {
+
+    const int myNumInputs = theIsUnrolled ? theTopology->getNumPrimaryInputs() : theTopology->theCircuitInputs.size();
+    theDecisionInputs.reserve(theNumFrames * myNumInputs);
+    for (int myFrame = 0; myFrame < theNumFrames; myFrame++) {
+        for (int myInputIdx = 0; myInputIdx < myNumInputs; myInputIdx++) {
+            theDecisionInputs.push_back(myFrame * theNumFrameSignals + theTopology->theCircuitInputs[myInputIdx]);
+        }
+    }
 }
 
 
-Circuit::Circuit(const Circuit& other) :
-    theCircuit(other.theCircuit),
-    theCircuitState(other.theCircuitState),
-    theCircuitInputs(other.theCircuitInputs),
-    theCircuitOutputs(other.theCircuitOutputs),
-    theCircuitSignals(other.theCircuitSignals),
-    theFaultLocation(other.theFaultLocation),
-    theFaultValue(other.theFaultValue),
-    theDFrontier(other.theDFrontier),
-    theCircuitFileString(other.theCircuitFileString)
-{}
+// Orders the D-frontier by a permutation of the topology signals (empty for ascending ID), repeated frame by frame when unrolled
+// Resets the frontier, so this is set before a search starts; copies of the circuit share the order tables
+void Circuit::setDFrontierOrder(const std::vector<int>& aGateOrder){
+    if (aGateOrder.empty()) {
+        theDFrontier.setOrder(nullptr);
+        return;
+    }
+    std::shared_ptr<DFrontierOrder> myOrder = std::make_shared<DFrontierOrder>();
+    myOrder->theRanks = std::vector<int>(getNumSignals());
+    myOrder->theGates = std::vector<int>(getNumSignals());
+    for (int myFrame = 0; myFrame < theNumFrames; myFrame++) {
+        const int myFrameBase = myFrame * theNumFrameSignals;
+        for (int myRank = 0; myRank < theNumFrameSignals; myRank++) {
+            myOrder->theRanks[myFrameBase + aGateOrder[myRank]] = myFrameBase + myRank;
+            myOrder->theGates[myFrameBase + myRank] = myFrameBase + aGateOrder[myRank];
+        }
+    }
+    theDFrontier.setOrder(myOrder);
+}
 
 
-void printGate(Gate aGate) {
-    std::cout << aGate.gateType << std::endl;
-    for (auto& anInput : aGate.inputs) {
-        std::cout << anInput << ' ';
+// A present-state input of an unrolled frame reads the next-state signal of the previous frame
+int Circuit::getNumFanins(int aSignal) const {
+    int mySignal = getFrameSignal(aSignal);
+    if (theTopology->theGateTypes[mySignal] == GateType::INPUT) {
+        return (theIsUnrolled && getFrame(aSignal) > 0 && theTopology->thePresentStateCells[mySignal] >= 0) ? 1 : 0;
     }
-    std::cout << std::endl;
-    for (auto& anOutput : aGate.outputs) {
-        std::cout << anOutput << ' ';
+    return theTopology->faninEnd(mySignal) - theTopology->faninBegin(mySignal);
+}
+
+
+int Circuit::getFanin(int aSignal, int aFaninIdx) const {
+    int mySignal = getFrameSignal(aSignal);
+    int myFrameBase = aSignal - mySignal;
+    if (theTopology->theGateTypes[mySignal] == GateType::INPUT) {
+        return myFrameBase - theNumFrameSignals + theTopology->getNextState(theTopology->thePresentStateCells[mySignal]);
     }
-    std::cout << std::endl;
+    return myFrameBase + theTopology->faninBegin(mySignal)[aFaninIdx];
 }
 
 
-void Circuit::printCircuit() {}
+// Inputs the search may assign - every input under full scan, only the primary inputs of each frame when unrolled
+bool Circuit::isDecisionInput(int aSignal) const {
+    int mySignal = getFrameSignal(aSignal);
+    return theTopology->theGateTypes[mySignal] == GateType::INPUT && (!theIsUnrolled || theTopology->thePresentStateCells[mySignal] < 0);
+}
+
+
+// Whether some decision input can still reach the signal, i.e. it does not only depend on the unknown initial state
+bool Circuit::isControllable(int aSignal) const {
+    return !theIsUnrolled || theTopology->theSequentialDepth[getFrameSignal(aSignal)] <= getFrame(aSignal);
+}
+
+
+std::string Circuit::getSignalName(int aSignal) const {
+    if (!theIsUnrolled) {
+        return theTopology->theSignalNames[aSignal];
+    }
+    return theTopology->theSignalNames[getFrameSignal(aSignal)] + "@" + std::to_string(getFrame(aSignal));
+}
+
+
+std::size_t Circuit::getStateSizeInBytes() const {
+    return theCircuitState.sizeInBytes() + theRequiredStates.sizeInBytes() + theDFrontier.sizeInBytes() + theScheduled.sizeInBytes()
+         + theRequiredValues.capacity() * sizeof(std::pair<int, SignalType>)
+         + theTrail.capacity() * sizeof(TrailEntry)
+         + theDecisionCheckpoints.capacity() * sizeof(std::size_t)
+         + theDecisions.capacity() * sizeof(std::pair<int, SignalType>)
+         + theDecisionInputs.capacity() * sizeof(int)
+         + theChangedSignals.capacity() * sizeof(int)
+         + (theXPathStamps.capacity() + theXPathStack.capacity()) * sizeof(int);
+}
+
+
+void CircuitTopology::printCircuit() const {
+    for (int mySignal = 0; mySignal < getNumSignals(); mySignal++){
+        std::cout << "\n--- Gate: " << theSignalNames[mySignal] << " | Type: " << getGateTypeString(theGateTypes[mySignal]) << " ---" << std::endl;
+        std::cout << "Inputs: ";
+        for (const int* myFanin = faninBegin(mySignal); myFanin != faninEnd(mySignal); myFanin++) {
+            std::cout << theSignalNames[*myFanin] << " ";
+        }
+        std::cout << std::endl << "Outputs: ";
+        for (const int* myFanout = fanoutBegin(mySignal); myFanout != fanoutEnd(mySignal); myFanout++) {
+            std::cout << theSignalNames[*myFanout] << " ";
+        }
+        std::cout << std::endl;
+    }
+}
 
 
 void Circuit::printCircuitState(){
     std::cout << "\n\n----- Printing Circuit State -----" << std::endl;
-    for (auto& [myWireName, myWireState] : theCircuitState){
-        std::cout << std::setw(30) << myWireName << ": " << getSignalStateString(myWireState) << std::endl;
+    for (int mySignal = 0; mySignal < getNumSignals(); mySignal++){
+        std::cout << std::setw(30) << getSignalName(mySignal) << ": " << getSignalStateString(theCircuitState[mySignal]) << std::endl;
     }
     std::cout << std::endl;
 }
@@ -297,252 +1259,389 @@ void Circuit::printCircuitState(){
 
 void Circuit::printDFrontierGates(){
     std::cout << "\n\n----- Printing DFrontier Gates -----" << std::endl;
-    for (auto& dFrontierGate : theDFrontier){
-        std::cout << dFrontierGate << std::endl;
+    for (int dFrontierGate : theDFrontier){
+        std::cout << getSignalName(dFrontierGate) << std::endl;
     }
     std::cout << std::endl;
 }
 
 
-Circuit::~Circuit() {
-    if (theCircuitFile.is_open()) {
-        theCircuitFile.close();
-    }
-}
-
-
-bool Circuit::setCircuitFault(std::string aFaultLocation, SignalType aFaultValue){
+bool Circuit::setCircuitFault(int aFaultLocation, SignalType aFaultValue){
 
     if (aFaultValue != SignalType::D && aFaultValue != SignalType::D_b) {
         std::cout << "Error: Fault value must of type D or D_b" << std::endl;
         return false;
     }
 
-    if (vectorContains<std::string>(theCircuitSignals, aFaultLocation)){
+    if (aFaultLocation >= 0 && aFaultLocation < getNumSignals()){
         theFaultLocation = aFaultLocation;
+        theFaultFrameSignal = getFrameSignal(aFaultLocation);
         theFaultValue = aFaultValue;
+        theNumBacktracks = 0;
         #ifdef DEBUG
-        std::cout << "Info: Set fault value " << getSignalStateString(aFaultValue) << " to signal " << aFaultLocation<< std::endl;
+        std::cout << "Info: Set fault value " << getSignalStateString(aFaultValue) << " to signal " << getSignalName(aFaultLocation) << std::endl;
         #endif
         return true;
     } else {
-        std::cout << "Error: Unable to set fault value " << getSignalStateString(aFaultValue) << " to signal " << aFaultLocation<< std::endl;
+        std::cout << "Error: Unable to set fault value " << getSignalStateString(aFaultValue) << " to signal " << aFaultLocation << std::endl;
         return false;
     }
 }
 
 
-// Sets a circuit input and propogates the effect of the assignment all the way down the circuit
-ImplyReturnType Circuit::setAndImplyCircuitInput(std::string anInput, SignalType aValue){
+// Sets a circuit input and propogates the effect of the assignment down the circuit
+// Gates are evaluated level by level off the event wheel, so each affected gate is evaluated at most once
+// Returns the signals whose value changed, which stays valid until the next implication
+const std::vector<int>& Circuit::setAndImplyCircuitInput(int anInput, SignalType aValue){
+    theChangedSignals.clear();
+
     if (aValue != SignalType::ONE && aValue != SignalType::ZERO && aValue != SignalType::X) {
-        std::cout << "Error: setAndImply(" << anInput << ", " << getSignalStateString(aValue) << ") | Input value must of type 1 or 0" << std::endl;
-        return ImplyReturnType::ERROR;
+        std::cout << "Error: setAndImply(" << getSignalName(anInput) << ", " << getSignalStateString(aValue) << ") | Input value must of type 1 or 0" << std::endl;
+        return theChangedSignals;
     }
-    if (!vectorContains<std::string>(theCircuitInputs, anInput)){
-        std::cout << "Error: setAndImply(" << anInput << ", " << getSignalStateString(aValue) << ") | Signal " << anInput << " is not a valid circuit input" << std::endl;
-        return ImplyReturnType::ERROR;
+    if (!isDecisionInput(anInput)){
+        std::cout << "Error: setAndImply(" << getSignalName(anInput) << ", " << getSignalStateString(aValue) << ") | Signal " << getSignalName(anInput) << " is not a valid circuit input" << std::endl;
+        return theChangedSignals;
     }
 
-    // std::cout << "Info: Setting and implying value " << getSignalStateString(aValue) << " to signal " << anInput << std::endl;
-
-    ImplyReturnType myReturnCode = ImplyReturnType::NORMAL;
+    // std::cout << "Info: Setting and implying value " << getSignalStateString(aValue) << " to signal " << theTopology->theSignalNames[anInput] << std::endl;
 
-    bool mySignalIsOutputFlag = vectorContains<std::string>(theCircuitOutputs, anInput);
+    SignalType myNewSignalValue = applyFault(anInput, aValue);
+    if (myNewSignalValue == theCircuitState[anInput]) {
+        return theChangedSignals;
+    }
 
-    // If a fault location is seen, override the correct assignment
-    if ((anInput == theFaultLocation) && (aValue != SignalType::X)){
-        if (theFaultValue == SignalType::D){
-            if (aValue == SignalType::ZERO){
-                theCircuitState[anInput] = SignalType::ZERO;
-                myReturnCode = ImplyReturnType::MASKED;
-            } else {
-                theCircuitState[anInput] = SignalType::D;
-                myReturnCode = (mySignalIsOutputFlag) ? ImplyReturnType::DETECTED : ImplyReturnType::ACTIVATED;
+    int myMaxScheduledLevel = 0;
+    recordTrail(anInput);
+    writeSignal(anInput, myNewSignalValue);
+    scheduleFanouts(anInput, myMaxScheduledLevel);
+
+    // Fanouts always sit on a higher level, so a single ascending sweep sees every gate after all of its fanins settle
+    for (int myLevel = getLevel(anInput) + 1; myLevel <= myMaxScheduledLevel; myLevel++) {
+        // A cancelled search drops the pending events, everything already written stays on the trail
+        if (isCancelled()) {
+            for (; myLevel <= myMaxScheduledLevel; myLevel++) {
+                for (int myGate : theEventWheel[myLevel]) {
+                    theScheduled.erase(myGate);
+                }
+                theEventWheel[myLevel].clear();
             }
+            break;
         }
-        if (theFaultValue == SignalType::D_b){
-            if (aValue == SignalType::ONE){
-                theCircuitState[anInput] = SignalType::ONE;
-                myReturnCode = ImplyReturnType::MASKED;
-            } else {
-                theCircuitState[anInput] = SignalType::D_b;
-                myReturnCode = (mySignalIsOutputFlag) ? ImplyReturnType::DETECTED : ImplyReturnType::ACTIVATED;
+        std::vector<int>& myLevelEvents = theEventWheel[myLevel];
+        for (std::size_t myEventIdx = 0; myEventIdx < myLevelEvents.size(); myEventIdx++) {
+            int myGate = myLevelEvents[myEventIdx];
+            theScheduled.erase(myGate);
+            if (evaluateGate(myGate)) {
+                scheduleFanouts(myGate, myMaxScheduledLevel);
             }
         }
-    } else {
-        theCircuitState[anInput] = aValue;
+        myLevelEvents.clear();
     }
 
-    // Recursively perform signal assignment down the circuit
-    for (auto& fanoutSignal : theCircuit[anInput].outputs) {
-        // std::cout << "Debug: Checking gate " << fanoutSignal << " for update" << std::endl;
-        ImplyReturnType myNewReturnCode = evaluateGateRecursive(fanoutSignal);
+    // std::cout << "Info: Imply (" << theTopology->theSignalNames[anInput] << ", " << getSignalStateString(aValue) << ") returning with code: " << getReturnCodeString(getImplyStatus()) << std::endl;
+    // printCircuitState();
 
-        if (myReturnCode == ImplyReturnType::MASKED && (myNewReturnCode == ImplyReturnType::DETECTED || myNewReturnCode == ImplyReturnType::ACTIVATED)){
-            myReturnCode = ImplyReturnType::ERROR;
-        } else {
-            if (myReturnCode == ImplyReturnType::ERROR || myNewReturnCode == ImplyReturnType::ERROR){
-                myReturnCode = ImplyReturnType::ERROR;
-            } else if (myNewReturnCode == ImplyReturnType::DETECTED) {
-                myReturnCode = myNewReturnCode;
-            } else if (myNewReturnCode == ImplyReturnType::ACTIVATED && myReturnCode != ImplyReturnType::DETECTED) {
-                myReturnCode = myNewReturnCode;
-            } else if (myNewReturnCode == ImplyReturnType::MASKED){
-                if (myReturnCode == ImplyReturnType::DETECTED || myReturnCode == ImplyReturnType::ACTIVATED) {
-                    myReturnCode = ImplyReturnType::ERROR;
-                } else {
-                    myReturnCode = myNewReturnCode;
-                }
-            }
-        }
+    return theChangedSignals;
+}
+
+
+// Summarizes the effect of the current assignment on the fault
+ImplyReturnType Circuit::getImplyStatus() const {
+    if (theNumErrorOutputs > 0) {
+        return ImplyReturnType::DETECTED;
     }
+    if (theFaultLocation < 0) {
+        return ImplyReturnType::NORMAL;
+    }
+    SignalType myFaultSiteValue = theCircuitState[theFaultLocation];
+    if (myFaultSiteValue == SignalType::D || myFaultSiteValue == SignalType::D_b) {
+        return ImplyReturnType::ACTIVATED;
+    }
+    if (myFaultSiteValue != SignalType::X) {
+        return ImplyReturnType::MASKED;
+    }
+    return ImplyReturnType::NORMAL;
+}
 
-    // std::cout << "Info: Imply (" << anInput << ", " << getSignalStateString(aValue) << ") returning with code: " << getReturnCodeString(myReturnCode) << std::endl;
-    // printCircuitState();
 
-    return myReturnCode;
+// Returns the value a signal takes once the fault (if located on it) overrides the fault-free value
+SignalType Circuit::applyFault(int aSignal, SignalType aValue) const {
+    if ((getFrameSignal(aSignal) != theFaultFrameSignal) || (aValue == SignalType::X)){
+        return aValue;
+    }
+    // Only the fault-free half of an incoming error survives (an unrolled fault site can read its own effect from an earlier frame)
+    if (theFaultValue == SignalType::D){
+        return (aValue == SignalType::ZERO || aValue == SignalType::D_b) ? SignalType::ZERO : SignalType::D;
+    }
+    if (theFaultValue == SignalType::D_b){
+        return (aValue == SignalType::ONE || aValue == SignalType::D) ? SignalType::ONE : SignalType::D_b;
+    }
+    return aValue;
 }
 
 
-// Recursive call to evaluate the output of a gate and propogate assignemnt through the circuit
-ImplyReturnType Circuit::evaluateGateRecursive(std::string aGateName){
+// Saves the current value and D-frontier membership of a signal so it can be restored on backtrack
+void Circuit::recordTrail(int aSignal){
+    theTrail.push_back(TrailEntry{aSignal, theCircuitState[aSignal], theDFrontier.contains(aSignal)});
+}
 
-    ImplyReturnType myReturnCode = ImplyReturnType::NORMAL;
 
-    Gate aGate = theCircuit[aGateName];
-    SignalType myNewSignalValue = theCircuitState[aGate.inputs[0]];
-    SignalType myOldSignalValue = theCircuitState[aGateName];
+// Whether a signal value contradicts a required good-machine value
+static inline bool isRequiredConflict(SignalType aValue, SignalType aRequiredValue){
+    if (aValue == SignalType::X || aRequiredValue == SignalType::X) {
+        return false;
+    }
+    return ((aValue == SignalType::ONE || aValue == SignalType::D) ? SignalType::ONE : SignalType::ZERO) != aRequiredValue;
+}
 
-    bool myDInputFlag = theCircuitState[aGate.inputs[0]] == SignalType::D || theCircuitState[aGate.inputs[0]] == SignalType::D_b;
 
-    if (aGate.gateType == "BUFF" || aGate.gateType == "buff"){
-        myNewSignalValue = theCircuitState[aGate.inputs[0]];
-    } else if (aGate.gateType == "NOT" || aGate.gateType == "not"){
-        myNewSignalValue = opNOT[theCircuitState[aGate.inputs[0]]];
-    } else if (aGate.gateType == "AND" || aGate.gateType == "and"){
-        for (std::size_t myFaninIter = 1; myFaninIter < aGate.inputs.size(); myFaninIter++){
-            myNewSignalValue = opAND[myNewSignalValue][theCircuitState[aGate.inputs[myFaninIter]]];
-            myDInputFlag = myDInputFlag || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D_b;
+// Replaces the required values, counting the conflicts with the current state
+void Circuit::setRequiredValues(const std::vector<std::pair<int, SignalType>>& aRequiredValues){
+    for (auto& myRequiredValue : theRequiredValues) {
+        theRequiredStates.set(myRequiredValue.first, SignalType::X);
+    }
+    theRequiredValues = aRequiredValues;
+    theNumRequiredConflicts = 0;
+    for (auto& [mySignal, myValue] : theRequiredValues) {
+        theRequiredStates.set(mySignal, myValue);
+        theNumRequiredConflicts += isRequiredConflict(theCircuitState[mySignal], myValue);
+    }
+}
+
+
+// Sets a signal value, keeping the output error and required value conflict counts up to date
+void Circuit::setSignal(int aSignal, SignalType aValue){
+    if ((*theObservedOutputs)[getFrameSignal(aSignal)]) {
+        SignalType myOldSignalValue = theCircuitState[aSignal];
+        theNumErrorOutputs -= (myOldSignalValue == SignalType::D || myOldSignalValue == SignalType::D_b);
+        theNumErrorOutputs += (aValue == SignalType::D || aValue == SignalType::D_b);
+    }
+    if (!theRequiredValues.empty()) {
+        SignalType myRequiredValue = theRequiredStates[aSignal];
+        theNumRequiredConflicts += isRequiredConflict(aValue, myRequiredValue) - isRequiredConflict(theCircuitState[aSignal], myRequiredValue);
+    }
+    theCircuitState.set(aSignal, aValue);
+}
+
+
+// Writes a new signal value during implication and records it in the change list
+void Circuit::writeSignal(int aSignal, SignalType aValue){
+    setSignal(aSignal, aValue);
+    theChangedSignals.push_back(aSignal);
+}
+
+
+// Queues a gate on the event wheel (once)
+void Circuit::scheduleGate(int aGate, int& aMaxScheduledLevel){
+    if (!theScheduled.contains(aGate)) {
+        int myLevel = getLevel(aGate);
+        theScheduled.insert(aGate);
+        theEventWheel[myLevel].push_back(aGate);
+        aMaxScheduledLevel = std::max(aMaxScheduledLevel, myLevel);
+    }
+}
+
+
+// Queues every fanout of a signal on the event wheel
+void Circuit::scheduleFanouts(int aSignal, int& aMaxScheduledLevel){
+    forEachFanout(aSignal, [&](int aFanout) { scheduleGate(aFanout, aMaxScheduledLevel); });
+}
+
+
+// Depth-first search from the D-frontier (or the fault site before activation) over X-valued fanouts
+// Every signal is visited at most once per check, and the search stops at the first observed output it reaches
+bool Circuit::hasXPath(){
+    if (++theXPathEpoch == INT_MAX) {
+        std::fill(theXPathStamps.begin(), theXPathStamps.end(), 0);
+        theXPathEpoch = 1;
+    }
+    theXPathStack.clear();
+    auto visit = [&](int aSignal) {
+        if (theXPathStamps[aSignal] != theXPathEpoch && theCircuitState[aSignal] == SignalType::X) {
+            theXPathStamps[aSignal] = theXPathEpoch;
+            theXPathStack.push_back(aSignal);
+        }
+    };
+
+    if (theCircuitState[theFaultLocation] == SignalType::X) {
+        visit(theFaultLocation);
+    } else {
+        for (int myDFrontierGate : theDFrontier) {
+            visit(myDFrontierGate);
         }
-    } else if (aGate.gateType == "NAND" || aGate.gateType == "nand"){
-        for (std::size_t myFaninIter = 1; myFaninIter < aGate.inputs.size(); myFaninIter++){
-            myNewSignalValue = opAND[myNewSignalValue][theCircuitState[aGate.inputs[myFaninIter]]];
-            myDInputFlag = myDInputFlag || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D_b;
+    }
+
+    while (!theXPathStack.empty()) {
+        int mySignal = theXPathStack.back();
+        theXPathStack.pop_back();
+        if ((*theObservedOutputs)[getFrameSignal(mySignal)]) {
+            return true;
         }
+        forEachFanout(mySignal, visit);
+    }
+    return false;
+}
+
+
+// Evaluates the output of a gate from its current inputs, updating the D-frontier
+// Returns true if the output value changed
+bool Circuit::evaluateGate(int aGate){
+
+    const int mySignal = getFrameSignal(aGate);
+    const int myFrameBase = aGate - mySignal;
+    const GateType myGateType = theTopology->theGateTypes[mySignal];
+    const int* myFanins = theTopology->faninBegin(mySignal);
+    const std::size_t myNumFanins = theTopology->faninEnd(mySignal) - myFanins;
+
+    // Only present-state inputs of an unrolled frame are ever evaluated as INPUT, they buffer the previous frame
+    SignalType myNewSignalValue = (myGateType == GateType::INPUT) ? theCircuitState[getFanin(aGate, 0)] : theCircuitState[myFrameBase + myFanins[0]];
+
+    bool myDInputFlag = myNewSignalValue == SignalType::D || myNewSignalValue == SignalType::D_b;
+
+    switch (myGateType) {
+    case GateType::INPUT:
+    case GateType::BUFF:
+        break;
+    case GateType::NOT:
         myNewSignalValue = opNOT[myNewSignalValue];
-    } else if (aGate.gateType == "OR" || aGate.gateType == "or"){
-        for (std::size_t myFaninIter = 1; myFaninIter < aGate.inputs.size(); myFaninIter++){
-            myNewSignalValue = opOR[myNewSignalValue][theCircuitState[aGate.inputs[myFaninIter]]];
-            myDInputFlag = myDInputFlag || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D_b;
+        break;
+    case GateType::AND:
+    case GateType::NAND:
+        for (std::size_t myFaninIter = 1; myFaninIter < myNumFanins; myFaninIter++){
+            SignalType myFaninValue = theCircuitState[myFrameBase + myFanins[myFaninIter]];
+            myNewSignalValue = opAND[myNewSignalValue][myFaninValue];
+            myDInputFlag = myDInputFlag || myFaninValue == SignalType::D || myFaninValue == SignalType::D_b;
         }
-    } else if (aGate.gateType == "NOR" || aGate.gateType == "nor"){
-        for (std::size_t myFaninIter = 1; myFaninIter < aGate.inputs.size(); myFaninIter++){
-            myNewSignalValue = opOR[myNewSignalValue][theCircuitState[aGate.inputs[myFaninIter]]];
-            myDInputFlag = myDInputFlag || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D_b;
+        if (myGateType == GateType::NAND) {
+            myNewSignalValue = opNOT[myNewSignalValue];
         }
-        myNewSignalValue = opNOT[myNewSignalValue];
-    } else if (aGate.gateType == "XOR" || aGate.gateType == "xor"){
-        for (std::size_t myFaninIter = 1; myFaninIter < aGate.inputs.size(); myFaninIter++){
-            myNewSignalValue = opXOR[myNewSignalValue][theCircuitState[aGate.inputs[myFaninIter]]];
-            myDInputFlag = myDInputFlag || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D_b;
+        break;
+    case GateType::OR:
+    case GateType::NOR:
+        for (std::size_t myFaninIter = 1; myFaninIter < myNumFanins; myFaninIter++){
+            SignalType myFaninValue = theCircuitState[myFrameBase + myFanins[myFaninIter]];
+            myNewSignalValue = opOR[myNewSignalValue][myFaninValue];
+            myDInputFlag = myDInputFlag || myFaninValue == SignalType::D || myFaninValue == SignalType::D_b;
         }
-    } else if (aGate.gateType == "XNOR" || aGate.gateType == "xnor"){
-        for (std::size_t myFaninIter = 1; myFaninIter < aGate.inputs.size(); myFaninIter++){
-            myNewSignalValue = opXOR[myNewSignalValue][theCircuitState[aGate.inputs[myFaninIter]]];
-            myDInputFlag = myDInputFlag || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D || theCircuitState[aGate.inputs[myFaninIter]] == SignalType::D_b;
+        if (myGateType == GateType::NOR) {
+            myNewSignalValue = opNOT[myNewSignalValue];
         }
-        myNewSignalValue = opNOT[myNewSignalValue];
-    } else {
-        std::cout << "Error: Unable to match gate " << aGate.gateType << std::endl;
-        myReturnCode = ImplyReturnType::ERROR;
-    }
-
-    if (myNewSignalValue == SignalType::X && myDInputFlag) {
-        theDFrontier.insert(aGateName);
-    } else {
-        theDFrontier.erase(aGateName);
+        break;
+    case GateType::XOR:
+    case GateType::XNOR:
+        for (std::size_t myFaninIter = 1; myFaninIter < myNumFanins; myFaninIter++){
+            SignalType myFaninValue = theCircuitState[myFrameBase + myFanins[myFaninIter]];
+            myNewSignalValue = opXOR[myNewSignalValue][myFaninValue];
+            myDInputFlag = myDInputFlag || myFaninValue == SignalType::D || myFaninValue == SignalType::D_b;
+        }
+        if (myGateType == GateType::XNOR) {
+            myNewSignalValue = opNOT[myNewSignalValue];
+        }
+        break;
+    default:
+        std::cout << "Error: Unable to match gate " << getGateTypeString(myGateType) << std::endl;
+        break;
     }
 
-    bool mySignalIsOutputFlag = vectorContains<std::string>(theCircuitOutputs, aGateName);
+    bool myInDFrontier = (myNewSignalValue == SignalType::X) && myDInputFlag;
+    bool myWasInDFrontier = theDFrontier.contains(aGate);
 
     // Override assignment if a fault location is seen
-    if ((aGateName == theFaultLocation) && (myNewSignalValue != SignalType::X)){
-        if (theFaultValue == SignalType::D){
-            if (myNewSignalValue == SignalType::ZERO){
-                theCircuitState[aGateName] = myNewSignalValue;
-                myReturnCode = ImplyReturnType::MASKED;
-            } else {
-                theCircuitState[aGateName] = SignalType::D;
-                myReturnCode = ImplyReturnType::ACTIVATED;
-            }
-        }
-        if (theFaultValue == SignalType::D_b){
-            if (myNewSignalValue == SignalType::ONE){
-                theCircuitState[aGateName] = myNewSignalValue;
-                myReturnCode = ImplyReturnType::MASKED;
-            } else {
-                theCircuitState[aGateName] = SignalType::D_b;
-                myReturnCode = ImplyReturnType::ACTIVATED;
-            }
-        }
-    } else {
-        theCircuitState[aGateName] = myNewSignalValue;
+    myNewSignalValue = applyFault(aGate, myNewSignalValue);
+
+    bool myValueChanged = myNewSignalValue != theCircuitState[aGate];
+    if (!myValueChanged && myInDFrontier == myWasInDFrontier) {
+        return false;
     }
 
-    if (mySignalIsOutputFlag && (myNewSignalValue == SignalType::D || myNewSignalValue == SignalType::D_b)) {
-        myReturnCode = ImplyReturnType::DETECTED;
+    recordTrail(aGate);
+    if (myInDFrontier != myWasInDFrontier) {
+        if (myInDFrontier) {
+            theDFrontier.insert(aGate);
+        } else {
+            theDFrontier.erase(aGate);
+        }
+    }
+    if (myValueChanged) {
+        writeSignal(aGate, myNewSignalValue);
     }
+    return myValueChanged;
+}
 
-    // Return code priority determination
-    if (myNewSignalValue != myOldSignalValue){
-        for (auto& fanoutSignal : aGate.outputs) {
-            // std::cout << "Debug: Checking gate " << fanoutSignal << " for update" << std::endl;
-            ImplyReturnType myNewReturnCode = evaluateGateRecursive(fanoutSignal);
 
-            if (myReturnCode == ImplyReturnType::MASKED && (myNewReturnCode == ImplyReturnType::DETECTED || myNewReturnCode == ImplyReturnType::ACTIVATED)){
-                myReturnCode = ImplyReturnType::ERROR;
-            } else {
-                if (myReturnCode == ImplyReturnType::ERROR || myNewReturnCode == ImplyReturnType::ERROR){
-                    myReturnCode = ImplyReturnType::ERROR;
-                } else if (myNewReturnCode == ImplyReturnType::DETECTED) {
-                    myReturnCode = myNewReturnCode;
-                } else if (myNewReturnCode == ImplyReturnType::ACTIVATED && myReturnCode != ImplyReturnType::DETECTED) {
-                    myReturnCode = myNewReturnCode;
-                } else if (myNewReturnCode == ImplyReturnType::MASKED){
-                    if (myReturnCode == ImplyReturnType::DETECTED || myReturnCode == ImplyReturnType::ACTIVATED) {
-                        myReturnCode = ImplyReturnType::ERROR;
-                    } else {
-                        myReturnCode = myNewReturnCode;
-                    }
-                }
-            }
+// Initialize circuit to all Xs
+void Circuit::resetCircuit(){
+    theCircuitState.fill(SignalType::X);
+    theDFrontier.clear();
+    theChangedSignals.clear();
+    theNumErrorOutputs = 0;
+    theNumRequiredConflicts = 0;
+    theTrail.clear();
+    theDecisions.clear();
+    theDecisionCheckpoints.clear();
+}
+
+
+// Undo every signal change recorded after the given checkpoint, newest first
+void Circuit::restore(std::size_t aCheckpoint){
+    while (theTrail.size() > aCheckpoint) {
+        const TrailEntry& myEntry = theTrail.back();
+        setSignal(myEntry.signal, myEntry.value);
+        if (myEntry.inDFrontier) {
+            theDFrontier.insert(myEntry.signal);
+        } else {
+            theDFrontier.erase(myEntry.signal);
         }
+        theTrail.pop_back();
     }
+    theChangedSignals.clear();
+}
 
-    theCircuit[aGateName] = aGate;
-    return myReturnCode;
 
+// Checkpoint the circuit, then set and imply a decision on a circuit input
+void Circuit::pushDecision(int anInput, SignalType aValue){
+    theDecisionCheckpoints.push_back(checkpoint());
+    theDecisions.push_back(std::pair<int, SignalType>(anInput, aValue));
+    setAndImplyCircuitInput(anInput, aValue);
 }
 
 
-// Initialize circuit to all Xs
-void Circuit::resetCircuit(){
-    for(auto& aCircuitInput: theCircuitInputs){
-        setAndImplyCircuitInput(aCircuitInput, SignalType::X);
+// Undo the most recent decision and everything it implied
+void Circuit::popDecision(){
+    restore(theDecisionCheckpoints.back());
+    theDecisionCheckpoints.pop_back();
+    theDecisions.pop_back();
+}
+
+
+// Move the circuit to the search node described by a list of decisions
+// Only the decisions past the common prefix with the current node are undone and replayed
+void Circuit::syncDecisions(const std::vector<std::pair<int, SignalType>>& aDecisions){
+    std::size_t myCommonDecisions = 0;
+    while (myCommonDecisions < theDecisions.size() && myCommonDecisions < aDecisions.size() && theDecisions[myCommonDecisions] == aDecisions[myCommonDecisions]) {
+        myCommonDecisions++;
+    }
+    while (theDecisions.size() > myCommonDecisions) {
+        popDecision();
+    }
+    for (std::size_t myDecisionIdx = myCommonDecisions; myDecisionIdx < aDecisions.size(); myDecisionIdx++) {
+        pushDecision(aDecisions[myDecisionIdx].first, aDecisions[myDecisionIdx].second);
     }
 }
 
 
-// Return map of all current circuit inputs to values
-std::unordered_map<std::string, SignalType> Circuit::getCurrCircuitInputValues(){
-    std::unordered_map<std::string, SignalType> myCurrCircuitInputValues = std::unordered_map<std::string, SignalType>();
-    for (auto& myInput : theCircuitInputs) {
+// Return current value of each decision input, in the order of theDecisionInputs
+std::vector<SignalType> Circuit::getCurrCircuitInputValues(){
+    std::vector<SignalType> myCurrCircuitInputValues = std::vector<SignalType>();
+    myCurrCircuitInputValues.reserve(theDecisionInputs.size());
+    for (auto& myInput : theDecisionInputs) {
         if (theCircuitState[myInput] == SignalType::D){
-            myCurrCircuitInputValues[myInput] = SignalType::ONE;
+            myCurrCircuitInputValues.push_back(SignalType::ONE);
         } else if (theCircuitState[myInput] == SignalType::D_b){
-            myCurrCircuitInputValues[myInput] = SignalType::ZERO;
+            myCurrCircuitInputValues.push_back(SignalType::ZERO);
         } else {
-            myCurrCircuitInputValues[myInput] = theCircuitState[myInput];
+            myCurrCircuitInputValues.push_back(theCircuitState[myInput]);
         }
     }
     return myCurrCircuitInputValues;
@@ -10,9 +10,13 @@
 #include <cmath>
 #include <climits>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <cstdint>
+#include <atomic>
+#include <memory>
 #include <filesystem>
 
 #include <unistd.h>
@@ -62,22 +66,69 @@ typedef enum GateType {
     NAND,
     NOR,
     BUFF,
-    XNOR
+    XNOR,
+    INPUT
 } GateType;
 
+// Map for printing gate types
+const std::unordered_map<GateType, std::string> gateTypeNames = {
+    {GateType::AND, "AND"},
+    {GateType::OR, "OR"},
+    {GateType::NOT, "NOT"},
+    {GateType::XOR, "XOR"},
+    {GateType::NAND, "NAND"},
+    {GateType::NOR, "NOR"},
+    {GateType::BUFF, "BUFF"},
+    {GateType::XNOR, "XNOR"},
+    {GateType::INPUT, "INPUT"}
+};
+
 std::string getSignalStateString(SignalType aSignal);
+std::string getGateTypeString(GateType aGateType);
+bool getGateType(std::string_view aGateTypeString, GateType& aGateType);
+
+bool string_is_whitespace(std::string& s);
+std::vector<std::string> tokenize_line(std::string s);
 
-// Circuit Gate class
-struct Gate {
-    std::string gateType;
-    std::vector<std::string> inputs;
-    std::vector<std::string> outputs;
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile(const std::string& aFileString);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return theIsOpen; }
+    const char* data() const { return theData; }
+    std::size_t size() const { return theSize; }
 
-    Gate(std::string gateType, std::vector<std::string> inputs, std::vector<std::string> outputs) : gateType(gateType), inputs(inputs), outputs(outputs) {}
-    Gate() : gateType(""), inputs(), outputs() {}
+private:
+    const char* theData;
+    std::size_t theSize;
+    bool theIsOpen;
 };
 
-void printGate(Gate aGate);
+// Parse-time netlist, compiled into the integer-indexed netlist once the file is read
+// Wire names are views into the source text, interned in order of first appearance
+struct ParsedNetlist {
+    std::vector<std::string_view> wireNames;
+    std::unordered_map<std::string_view, int> wireIds;
+
+    // One gate per defined wire (circuit inputs included), in file order
+    std::vector<int> gateOutputs;
+    std::vector<GateType> gateTypes;
+    std::vector<int> gateFaninOffsets = std::vector<int>(1, 0);
+    std::vector<int> gateFanins;
+
+    std::vector<int> circuitInputs;
+    std::vector<int> circuitOutputs;
+
+    // Flip-flops of a full-scan design as (Q, D) wire pairs, in file order
+    std::vector<std::pair<int, int>> scanCells;
+
+    int internWire(std::string_view aWireName);
+    void addGate(int anOutputWire, GateType aGateType);
+};
 
 // Gate output lookup tables (inspired by 18-765 cframe.py)
 const SignalType opAND [5][5] = {
@@ -108,47 +159,477 @@ const SignalType opNOT [5] = {SignalType::ONE, SignalType::ZERO, SignalType::D_b
 
 template <typename T>
 bool vectorContains(std::vector<T> aVector, T aValue){
-    return (std::ranges::find(aVector, aValue) != aVector.end());
+    return (std::find(aVector.begin(), aVector.end(), aValue) != aVector.end());
 }
 
+// Compact signal state - 3 bits per signal, 21 signals packed into each 64-bit word
+class PackedSignalArray {
+public:
+    PackedSignalArray() : theSize(0) {}
+    PackedSignalArray(std::size_t aSize, SignalType aValue) : theSize(aSize) {
+        theWords = std::vector<std::uint64_t>((aSize + SIGNALS_PER_WORD - 1) / SIGNALS_PER_WORD);
+        fill(aValue);
+    }
+
+    SignalType operator[](std::size_t anIdx) const {
+        return static_cast<SignalType>((theWords[anIdx / SIGNALS_PER_WORD] >> (3 * (anIdx % SIGNALS_PER_WORD))) & 0x7);
+    }
+    void set(std::size_t anIdx, SignalType aValue) {
+        std::uint64_t& myWord = theWords[anIdx / SIGNALS_PER_WORD];
+        const int myShift = 3 * (anIdx % SIGNALS_PER_WORD);
+        myWord = (myWord & ~(std::uint64_t(0x7) << myShift)) | (std::uint64_t(aValue) << myShift);
+    }
+    void fill(SignalType aValue) {
+        std::uint64_t myWord = 0;
+        for (int mySlot = 0; mySlot < SIGNALS_PER_WORD; mySlot++) {
+            myWord |= std::uint64_t(aValue) << (3 * mySlot);
+        }
+        std::fill(theWords.begin(), theWords.end(), myWord);
+    }
+    std::size_t size() const { return theSize; }
+    std::size_t sizeInBytes() const { return theWords.size() * sizeof(std::uint64_t); }
+
+private:
+    static const int SIGNALS_PER_WORD = 21;
+
+    std::vector<std::uint64_t> theWords;
+    std::size_t theSize;
+};
+
+// Fixed-size set of signal IDs stored as a bitset, iterated in ascending ID order
+class SignalBitset {
+public:
+    SignalBitset() : theCount(0) {}
+    SignalBitset(std::size_t aSize) : theWords((aSize + 63) / 64, 0), theCount(0) {}
+
+    bool contains(int aSignal) const { return (theWords[aSignal >> 6] >> (aSignal & 63)) & 1; }
+    void insert(int aSignal) {
+        if (!contains(aSignal)) {
+            theWords[aSignal >> 6] |= std::uint64_t(1) << (aSignal & 63);
+            theCount++;
+        }
+    }
+    void erase(int aSignal) {
+        if (contains(aSignal)) {
+            theWords[aSignal >> 6] &= ~(std::uint64_t(1) << (aSignal & 63));
+            theCount--;
+        }
+    }
+    void clear() {
+        std::fill(theWords.begin(), theWords.end(), 0);
+        theCount = 0;
+    }
+    bool empty() const { return theCount == 0; }
+    int size() const { return theCount; }
+    std::size_t sizeInBytes() const { return theWords.size() * sizeof(std::uint64_t); }
+
+    // Returns the first member with ID >= aSignal, or -1 if there is none
+    int findNext(int aSignal) const {
+        std::size_t myWordIdx = aSignal >> 6;
+        if (myWordIdx >= theWords.size()) {
+            return -1;
+        }
+        std::uint64_t myWord = theWords[myWordIdx] & (~std::uint64_t(0) << (aSignal & 63));
+        while (myWord == 0) {
+            if (++myWordIdx >= theWords.size()) {
+                return -1;
+            }
+            myWord = theWords[myWordIdx];
+        }
+        return (myWordIdx << 6) + __builtin_ctzll(myWord);
+    }
+
+    class const_iterator {
+    public:
+        const_iterator(const SignalBitset* aSet, int aSignal) : theSet(aSet), theSignal(aSignal) {}
+        int operator*() const { return theSignal; }
+        const_iterator& operator++() { theSignal = theSet->findNext(theSignal + 1); return *this; }
+        bool operator!=(const const_iterator& other) const { return theSignal != other.theSignal; }
+    private:
+        const SignalBitset* theSet;
+        int theSignal;
+    };
+
+    const_iterator begin() const { return const_iterator(this, theCount ? findNext(0) : -1); }
+    const_iterator end() const { return const_iterator(this, -1); }
+
+private:
+    std::vector<std::uint64_t> theWords;
+    int theCount;
+};
+
+// Visiting order of the D-frontier - theRanks[gate] is the slot of a gate and theGates[slot] the gate in that slot
+struct DFrontierOrder {
+    std::vector<int> theRanks;
+    std::vector<int> theGates;
+};
+
+// D-frontier as a bitset over order slots, so iteration (and the objective taken from begin()) follows the chosen
+// order no matter which sequence of insertions and trail restores produced the current members
+// A summary bit per word of slots keeps finding the next member cheap when the frontier is sparse
+class DFrontier {
+public:
+    DFrontier() : theCount(0) {}
+    DFrontier(std::size_t aSize) : theWords((aSize + 63) / 64, 0), theSummary((theWords.size() + 63) / 64, 0), theCount(0) {}
+
+    // Switches the visiting order (nullptr for ascending gate ID); the frontier is emptied
+    void setOrder(std::shared_ptr<const DFrontierOrder> anOrder) {
+        clear();
+        theOrder = anOrder;
+    }
+    const std::shared_ptr<const DFrontierOrder>& getOrder() const { return theOrder; }
+
+    bool contains(int aGate) const {
+        int mySlot = getSlot(aGate);
+        return (theWords[mySlot >> 6] >> (mySlot & 63)) & 1;
+    }
+    void insert(int aGate) {
+        int mySlot = getSlot(aGate);
+        std::uint64_t& myWord = theWords[mySlot >> 6];
+        std::uint64_t myBit = std::uint64_t(1) << (mySlot & 63);
+        if (!(myWord & myBit)) {
+            myWord |= myBit;
+            theSummary[mySlot >> 12] |= std::uint64_t(1) << ((mySlot >> 6) & 63);
+            theCount++;
+        }
+    }
+    void erase(int aGate) {
+        int mySlot = getSlot(aGate);
+        std::uint64_t& myWord = theWords[mySlot >> 6];
+        std::uint64_t myBit = std::uint64_t(1) << (mySlot & 63);
+        if (myWord & myBit) {
+            myWord &= ~myBit;
+            if (myWord == 0) {
+                theSummary[mySlot >> 12] &= ~(std::uint64_t(1) << ((mySlot >> 6) & 63));
+            }
+            theCount--;
+        }
+    }
+    void clear() {
+        std::fill(theWords.begin(), theWords.end(), 0);
+        std::fill(theSummary.begin(), theSummary.end(), 0);
+        theCount = 0;
+    }
+    bool empty() const { return theCount == 0; }
+    int size() const { return theCount; }
+    std::size_t sizeInBytes() const { return (theWords.size() + theSummary.size()) * sizeof(std::uint64_t); }
+
+    // Returns the first occupied slot >= aSlot, or -1 if there is none
+    int findNextSlot(int aSlot) const {
+        std::size_t myWordIdx = aSlot >> 6;
+        if (myWordIdx >= theWords.size()) {
+            return -1;
+        }
+        std::uint64_t myWord = theWords[myWordIdx] & (~std::uint64_t(0) << (aSlot & 63));
+        if (myWord != 0) {
+            return (myWordIdx << 6) + __builtin_ctzll(myWord);
+        }
+
+        // Skip empty words through the summary
+        myWordIdx++;
+        std::size_t mySummaryIdx = myWordIdx >> 6;
+        if (mySummaryIdx >= theSummary.size()) {
+            return -1;
+        }
+        std::uint64_t mySummaryWord = theSummary[mySummaryIdx] & (~std::uint64_t(0) << (myWordIdx & 63));
+        while (mySummaryWord == 0) {
+            if (++mySummaryIdx >= theSummary.size()) {
+                return -1;
+            }
+            mySummaryWord = theSummary[mySummaryIdx];
+        }
+        myWordIdx = (mySummaryIdx << 6) + __builtin_ctzll(mySummaryWord);
+        return (myWordIdx << 6) + __builtin_ctzll(theWords[myWordIdx]);
+    }
+
+    class const_iterator {
+    public:
+        const_iterator(const DFrontier* aSet, int aSlot) : theSet(aSet), theSlot(aSlot) {}
+        int operator*() const { return theSet->getGate(theSlot); }
+        const_iterator& operator++() { theSlot = theSet->findNextSlot(theSlot + 1); return *this; }
+        bool operator!=(const const_iterator& other) const { return theSlot != other.theSlot; }
+    private:
+        const DFrontier* theSet;
+        int theSlot;
+    };
+
+    const_iterator begin() const { return const_iterator(this, theCount ? findNextSlot(0) : -1); }
+    const_iterator end() const { return const_iterator(this, -1); }
+
+private:
+    int getSlot(int aGate) const { return theOrder ? theOrder->theRanks[aGate] : aGate; }
+    int getGate(int aSlot) const { return theOrder ? theOrder->theGates[aSlot] : aSlot; }
+
+    std::vector<std::uint64_t> theWords;
+    std::vector<std::uint64_t> theSummary;
+    int theCount;
+    std::shared_ptr<const DFrontierOrder> theOrder;
+};
+
+// Binary netlist cache, written next to the source file as <source>.nlc
+// Bump the version whenever the layout or the meaning of any cached array changes
+#define NETLIST_CACHE_EXTENSION ".nlc"
+#define NETLIST_CACHE_VERSION 2
+
+// SCOAP measures saturate here, so unreachable or unobservable signals stay comparable
+#define SCOAP_INFINITY 1000000000
+
+std::uint64_t hash_bytes(const char* aData, std::size_t aSize);
+
+// Immutable compiled netlist, shared by every Circuit searching on it
+// Signals are interned to integer IDs at parse time; names are only kept for I/O
+class CircuitTopology {
+public:
+    CircuitTopology(const std::string aCircuitFileString);
+
+    int getNumSignals() const { return theSignalNames.size(); }
+    int getSignalId(const std::string& aSignalName) const;
+
+    // Real inputs/outputs come first, the flip-flop of scan cell c is (getPresentState(c), getNextState(c))
+    int getNumPrimaryInputs() const { return theCircuitInputs.size() - theNumScanCells; }
+    int getNumPrimaryOutputs() const { return theCircuitOutputs.size() - theNumScanCells; }
+    int getPresentState(int aCell) const { return theCircuitInputs[getNumPrimaryInputs() + aCell]; }
+    int getNextState(int aCell) const { return theCircuitOutputs[getNumPrimaryOutputs() + aCell]; }
+
+    // Fanin/fanout of a signal in the CSR arrays: [begin, end)
+    const int* faninBegin(int aSignal) const { return theFanins.data() + theFaninOffsets[aSignal]; }
+    const int* faninEnd(int aSignal) const { return theFanins.data() + theFaninOffsets[aSignal + 1]; }
+    const int* fanoutBegin(int aSignal) const { return theFanouts.data() + theFanoutOffsets[aSignal]; }
+    const int* fanoutEnd(int aSignal) const { return theFanouts.data() + theFanoutOffsets[aSignal + 1]; }
+
+    void printCircuit() const;
+
+    std::string theCircuitFileString;
+
+    // Compiled netlist
+    std::vector<std::string> theSignalNames;
+    std::vector<GateType> theGateTypes;
+    std::vector<int> theFaninOffsets;
+    std::vector<int> theFanins;
+    std::vector<int> theFanoutOffsets;
+    std::vector<int> theFanouts;
+    std::vector<std::uint8_t> theIsOutput;
+
+    // Levelization - every gate sits strictly above all of its fanins
+    std::vector<int> theLevels;
+    int theMaxLevel;
+
+    // Every signal, fanins before fanouts
+    std::vector<int> theTopologicalOrder;
+
+    // Full scan - the last theNumScanCells inputs/outputs are the pseudo-primary inputs (Q) and
+    // outputs (D) of the flip-flops, both in scan chain order
+    std::vector<int> theCircuitInputs;
+    std::vector<int> theCircuitOutputs;
+    int theNumScanCells;
+
+    // SCOAP testability - combinational 0/1-controllability and observability of each signal
+    std::vector<int> theCC0;
+    std::vector<int> theCC1;
+    std::vector<int> theCO;
+
+    // Flip-flop connectivity used to chain the time frames of an unrolled circuit (derived, not cached)
+    // Scan cell read by each present-state signal (-1 otherwise) and the cells each signal feeds, in CSR form
+    std::vector<int> thePresentStateCells;
+    std::vector<int> theNextStateOffsets;
+    std::vector<int> theNextStateCells;
+    // Outputs observable without scan, and the fewest earlier frames a signal needs to reach a primary input
+    std::vector<std::uint8_t> theIsPrimaryOutput;
+    std::vector<int> theSequentialDepth;
+
+private:
+    // Open-addressed name -> ID table, power-of-two sized, -1 marks an empty slot
+    std::vector<int> theSignalIndex;
+
+    void parse_bench(const char* aBegin, const char* anEnd, ParsedNetlist& aNetlist);
+    void parse_verilog(const char* aBegin, const char* anEnd, ParsedNetlist& aNetlist);
+    void compile_circuit(const ParsedNetlist& aNetlist);
+    void levelize_circuit();
+    void compute_testability();
+    void build_signal_index();
+    void build_frame_map();
+
+    bool load_cache(const std::string& aCacheFileString, std::uint64_t aSourceHash);
+    bool write_cache(const std::string& aCacheFileString, std::uint64_t aSourceHash) const;
+};
+
+// Single stuck-at fault universe of a topology, collapsed by structural equivalence and dominance
+// Fault 2 * s is signal s stuck-at-0 (fault value D), 2 * s + 1 is s stuck-at-1 (D_b)
+class FaultList {
+public:
+    FaultList(const CircuitTopology& aTopology);
+
+    int getNumFaults() const { return theRepresentatives.size(); }
+    static int getFaultIdx(int aSignal, SignalType aFaultValue) { return 2 * aSignal + (aFaultValue == SignalType::D_b); }
+    static std::pair<int, SignalType> getFault(int aFaultIdx) { return std::pair<int, SignalType>(aFaultIdx >> 1, (aFaultIdx & 1) ? SignalType::D_b : SignalType::D); }
+
+    // Whether a fault represents its equivalence class and is not dropped by dominance, i.e. has to be targeted
+    bool isTarget(int aFaultIdx) const { return theRepresentatives[aFaultIdx] == aFaultIdx && theDominated[aFaultIdx] < 0; }
+
+    // Representative of the equivalence class of each fault - equivalent faults have exactly the same tests
+    std::vector<int> theRepresentatives;
+
+    // For a representative whose class dominates another class, that class's representative (-1 otherwise)
+    // Every test for the dominated class detects the dominating one, so the latter is only targeted if the former is not detected
+    std::vector<int> theDominated;
+
+    int theNumClasses;
+    int theNumTargets;
+};
+
 // Circuit class with PODEM-oriented optimizations and structures
+// Holds only the mutable search state; the netlist itself lives in the shared CircuitTopology
+// A circuit either searches the full-scan combinational core, or the design unrolled over a number of time frames
+// that all index the same topology (signal s of frame f has ID f * theTopology->getNumSignals() + s)
 class Circuit {
 public:
     Circuit();
     Circuit(const std::string aCircuitFileString);
-    Circuit(const Circuit& other);
-    Circuit& operator=(const Circuit& other);
-    ~Circuit();
+    Circuit(std::shared_ptr<const CircuitTopology> aTopology);
+    Circuit(std::shared_ptr<const CircuitTopology> aTopology, int aNumFrames);
 
-    bool setCircuitFault(std::string aFaultLocation, SignalType aFaultValue);
-    ImplyReturnType setAndImplyCircuitInput(std::string anInput, SignalType aValue);
+    bool setCircuitFault(int aFaultLocation, SignalType aFaultValue);
+    const std::vector<int>& setAndImplyCircuitInput(int anInput, SignalType aValue);
+    ImplyReturnType getImplyStatus() const;
+    bool errorAtOutput() const { return theNumErrorOutputs > 0; }
     void resetCircuit();
-    std::unordered_map<std::string, SignalType> getCurrCircuitInputValues();
+    std::vector<SignalType> getCurrCircuitInputValues();
 
-    std::unordered_map<std::string, Gate> theCircuit;
-    std::unordered_map<std::string, SignalType> theCircuitState;
+    SignalType getSignalState(int aSignal) const { return theCircuitState[aSignal]; }
 
-    std::vector<std::string> theCircuitInputs;
-    std::vector<std::string> theCircuitOutputs;
-    std::vector<std::string> theCircuitSignals;
+    // Time-frame expansion - frame 0 starts from an unknown state and only the primary outputs of a frame are observed
+    int getNumSignals() const { return theNumFrames * theNumFrameSignals; }
+    int getNumFrames() const { return theNumFrames; }
+    bool isUnrolled() const { return theIsUnrolled; }
+    int getFrame(int aSignal) const { return theNumFrames == 1 ? 0 : aSignal / theNumFrameSignals; }
+    int getFrameSignal(int aSignal) const { return theNumFrames == 1 ? aSignal : aSignal % theNumFrameSignals; }
+    GateType getGateType(int aSignal) const { return theTopology->theGateTypes[getFrameSignal(aSignal)]; }
+    int getNumFanins(int aSignal) const;
+    int getFanin(int aSignal, int aFaninIdx) const;
+    bool isDecisionInput(int aSignal) const;
+    bool isControllable(int aSignal) const;
+    std::string getSignalName(int aSignal) const;
 
-    std::string theFaultLocation;
+    // Undo trail - checkpoint() marks the current state, restore() rolls every change since then back
+    std::size_t checkpoint() const { return theTrail.size(); }
+    void restore(std::size_t aCheckpoint);
+
+    // Decision stack on top of the trail, used to move a circuit between nodes of the PODEM decision tree
+    void pushDecision(int anInput, SignalType aValue);
+    void popDecision();
+    void syncDecisions(const std::vector<std::pair<int, SignalType>>& aDecisions);
+
+    // X-path check - false once no error (or the unactivated fault site) can reach an observed output through X signals
+    bool hasXPath();
+
+    // Good-machine values every test for the current fault has to produce, in the order they were derived
+    // An error counts with its fault-free value; a conflict means no test lies below the current search node
+    void setRequiredValues(const std::vector<std::pair<int, SignalType>>& aRequiredValues);
+    const std::vector<std::pair<int, SignalType>>& getRequiredValues() const { return theRequiredValues; }
+    bool hasRequiredConflict() const { return theNumRequiredConflicts > 0; }
+
+    // Cancellation of a parallel search - implication stops between levels once the token holds the circuit's search epoch
+    // A cut-short implication leaves the state half implied, so a cancelled circuit is only ever restored or reset
+    void setCancellation(const std::atomic<unsigned>* aCancelToken, unsigned anEpoch) { theCancelToken = aCancelToken; theCancelEpoch = anEpoch; }
+    bool isCancelled() const { return theCancelToken != nullptr && theCancelToken->load(std::memory_order_relaxed) == theCancelEpoch; }
+
+    // Bytes of per-search state owned by this circuit (excludes the shared topology)
+    std::size_t getStateSizeInBytes() const;
+
+    std::shared_ptr<const CircuitTopology> theTopology;
+
+    // Signals whose value changed during the last implication, in evaluation order
+    std::vector<int> theChangedSignals;
+
+    // Number of primary outputs currently carrying D or D_b
+    int theNumErrorOutputs;
+
+    int theFaultLocation;
     SignalType theFaultValue;
 
-    std::unordered_set<std::string> theDFrontier;
+    // Backtracks of the search on the current fault, reset by setCircuitFault
+    long theNumBacktracks;
+
+    // Gates with an X output and an error on some input, visited in the order set by setDFrontierOrder
+    DFrontier theDFrontier;
+    void setDFrontierOrder(const std::vector<int>& aGateOrder);
+
+    // Inputs the search assigns, in the order of the returned test vectors (frame by frame when unrolled)
+    std::vector<int> theDecisionInputs;
+
+    // Input assignments made so far, oldest first
+    std::vector<std::pair<int, SignalType>> theDecisions;
 
     void printCircuitState();
     void printDFrontierGates();
-    void printCircuit();
 
 private:
-    std::string theCircuitFileString;
-    std::ifstream theCircuitFile;
+    Circuit(std::shared_ptr<const CircuitTopology> aTopology, int aNumFrames, bool anIsUnrolled);
+
+    int theNumFrames;
+    int theNumFrameSignals;
+    bool theIsUnrolled;
+
+    // Topology ID of the fault site, which is faulty in every frame
+    int theFaultFrameSignal;
+
+    // Outputs whose errors count as a detection - all outputs under full scan, primary outputs when unrolled
+    const std::vector<std::uint8_t>* theObservedOutputs;
+
+    // Packed state array indexed by signal ID
+    PackedSignalArray theCircuitState;
+
+    // Required value of each signal (X if none), and how many signals currently contradict theirs
+    std::vector<std::pair<int, SignalType>> theRequiredValues;
+    PackedSignalArray theRequiredStates;
+    int theNumRequiredConflicts;
+
+    // Previous value and D-frontier membership of a signal, recorded before it is modified
+    struct TrailEntry {
+        int signal;
+        SignalType value;
+        bool inDFrontier;
+    };
+
+    std::vector<TrailEntry> theTrail;
+    std::vector<std::size_t> theDecisionCheckpoints;
+
+    // Event wheel - one bucket of pending gate evaluations per level
+    std::vector<std::vector<int>> theEventWheel;
+    SignalBitset theScheduled;
+
+    // X-path search scratch - a signal is visited in the current search when its stamp equals the epoch
+    std::vector<int> theXPathStamps;
+    int theXPathEpoch;
+    std::vector<int> theXPathStack;
+
+    // Token polled by implication, and the epoch of the search this circuit takes part in (no token outside parallel searches)
+    const std::atomic<unsigned>* theCancelToken;
+    unsigned theCancelEpoch;
 
-    std::unordered_map<std::string, std::vector<std::string>> get_wire_cnt(std::ifstream& file);
-    void populate_circuit(std::ifstream& aCircuitFile, std::unordered_map<std::string, std::vector<std::string>> aWireCnt);
+    // Calls aVisit on every fanout of a signal, including the present-state inputs of the next frame it feeds when unrolled
+    template <typename Visitor>
+    void forEachFanout(int aSignal, Visitor aVisit) const {
+        const int mySignal = getFrameSignal(aSignal);
+        const int myFrameBase = aSignal - mySignal;
+        for (const int* myFanout = theTopology->fanoutBegin(mySignal); myFanout != theTopology->fanoutEnd(mySignal); myFanout++) {
+            aVisit(myFrameBase + *myFanout);
+        }
+        if (theIsUnrolled && myFrameBase + theNumFrameSignals < getNumSignals()) {
+            for (int myCellIdx = theTopology->theNextStateOffsets[mySignal]; myCellIdx < theTopology->theNextStateOffsets[mySignal + 1]; myCellIdx++) {
+                aVisit(myFrameBase + theNumFrameSignals + theTopology->getPresentState(theTopology->theNextStateCells[myCellIdx]));
+            }
+        }
+    }
 
-    ImplyReturnType evaluateGateRecursive(std::string aGate);
+    int getLevel(int aSignal) const { return getFrame(aSignal) * (theTopology->theMaxLevel + 1) + theTopology->theLevels[getFrameSignal(aSignal)]; }
+    SignalType applyFault(int aSignal, SignalType aValue) const;
+    void recordTrail(int aSignal);
+    void setSignal(int aSignal, SignalType aValue);
+    void writeSignal(int aSignal, SignalType aValue);
+    void scheduleGate(int aGate, int& aMaxScheduledLevel);
+    void scheduleFanouts(int aSignal, int& aMaxScheduledLevel);
+    bool evaluateGate(int aGate);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "fsim.h"
+
+
+FaultSimulator::FaultSimulator(std::shared_ptr<const CircuitTopology> aTopology) :
+        theTopology(aTopology),
+        theGoodValues(aTopology->getNumSignals(), 0),
+        theFaultyValues(aTopology->getNumSignals(), 0),
+        thePropagator(aTopology->getNumSignals(), aTopology->theMaxLevel) {
+}
+
+
+// Two-valued evaluation of a gate from its fanin values (inputs keep the value they were given)
+std::uint8_t FaultSimulator::evaluate(int aGate, const std::vector<std::uint8_t>& aValues) const {
+    const CircuitTopology& myTopology = *theTopology;
+    const int* myFanin = myTopology.faninBegin(aGate);
+    const int* myFaninEnd = myTopology.faninEnd(aGate);
+
+    std::uint8_t myValue;
+    switch (myTopology.theGateTypes[aGate]) {
+    case GateType::AND:
+    case GateType::NAND:
+        myValue = 1;
+        for (; myFanin != myFaninEnd; myFanin++) {
+            myValue &= aValues[*myFanin];
+        }
+        return (myTopology.theGateTypes[aGate] == GateType::NAND) ? !myValue : myValue;
+    case GateType::OR:
+    case GateType::NOR:
+        myValue = 0;
+        for (; myFanin != myFaninEnd; myFanin++) {
+            myValue |= aValues[*myFanin];
+        }
+        return (myTopology.theGateTypes[aGate] == GateType::NOR) ? !myValue : myValue;
+    case GateType::XOR:
+    case GateType::XNOR:
+        myValue = 0;
+        for (; myFanin != myFaninEnd; myFanin++) {
+            myValue ^= aValues[*myFanin];
+        }
+        return (myTopology.theGateTypes[aGate] == GateType::XNOR) ? !myValue : myValue;
+    case GateType::NOT:
+        return !aValues[*myFanin];
+    case GateType::BUFF:
+        return aValues[*myFanin];
+    default:
+        return aValues[aGate];
+    }
+}
+
+
+void FaultSimulator::simulateGood(const std::vector<SignalType>& aTestVector) {
+    const CircuitTopology& myTopology = *theTopology;
+    for (std::size_t myInputIdx = 0; myInputIdx < aTestVector.size(); myInputIdx++) {
+        theGoodValues[myTopology.theCircuitInputs[myInputIdx]] = (aTestVector[myInputIdx] == SignalType::ONE);
+    }
+    for (int mySignal : myTopology.theTopologicalOrder) {
+        theGoodValues[mySignal] = evaluate(mySignal, theGoodValues);
+    }
+    theFaultyValues = theGoodValues;
+}
+
+
+// Faulty values are kept equal to the good ones between faults, so only the changed signals have to be restored
+bool FaultSimulator::detects(int aFaultLocation, SignalType aFaultValue) {
+    const CircuitTopology& myTopology = *theTopology;
+    const std::uint8_t myStuckValue = (aFaultValue == SignalType::D_b);
+    if (theGoodValues[aFaultLocation] == myStuckValue) {
+        return false;
+    }
+
+    bool myDetected = false;
+    thePropagator.propagate(TopologyNetlist{myTopology}, theFaultyValues, aFaultLocation, myStuckValue,
+        [&](int aGate, const std::vector<std::uint8_t>& aValues) { return evaluate(aGate, aValues); },
+        [&](int aSignal, std::uint8_t) { myDetected |= (myTopology.theIsOutput[aSignal] != 0); },
+        [&]() { return myDetected; });
+    thePropagator.restore(theFaultyValues, theGoodValues.data());
+    return myDetected;
+}
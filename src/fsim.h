@@ -0,0 +1,108 @@
+#ifndef FSIM_H
+#define FSIM_H
+
+#include "cframe.h"
+
+// Level-bucketed event propagation of one fault through its fanout cone, shared by the ATPG fault dropping and the
+// event-driven fault_sim backends
+// A netlist provides getLevel(signal) and forEachFanout(signal, visitor); the faulty state equals the good one
+// between faults, so restore() only has to undo the signals the last propagation changed
+template <typename Value>
+class EventPropagator {
+public:
+    EventPropagator(int aNumSignals, int aMaxLevel) :
+            theNumEvaluations(0),
+            theLevelEvents(aMaxLevel + 1),
+            theScheduled(aNumSignals, 0) {}
+
+    // Forces a signal to a value and re-evaluates, level by level, every gate with a changed input until anIsDone()
+    // holds or no event is left; aChange is called on every changed signal and its new value, the forced signal first
+    template <typename Netlist, typename Evaluate, typename Change, typename Done>
+    void propagate(const Netlist& aNetlist, std::vector<Value>& aFaultyState, int aSignal, Value aValue, Evaluate anEvaluate, Change aChange, Done anIsDone) {
+        auto change = [&](int aChangedSignal, Value aChangedValue) {
+            aFaultyState[aChangedSignal] = aChangedValue;
+            theChanged.push_back(aChangedSignal);
+            aChange(aChangedSignal, aChangedValue);
+            aNetlist.forEachFanout(aChangedSignal, [&](int aFanout) {
+                if (!theScheduled[aFanout]) {
+                    theScheduled[aFanout] = 1;
+                    theLevelEvents[aNetlist.getLevel(aFanout)].push_back(aFanout);
+                }
+            });
+        };
+
+        change(aSignal, aValue);
+        for (std::size_t myLevel = aNetlist.getLevel(aSignal) + 1; myLevel < theLevelEvents.size(); myLevel++) {
+            // Once done the rest of the events are only drained
+            for (int myGate : theLevelEvents[myLevel]) {
+                theScheduled[myGate] = 0;
+                if (anIsDone()) {
+                    continue;
+                }
+                theNumEvaluations++;
+                Value myValue = anEvaluate(myGate, aFaultyState);
+                if (myValue != aFaultyState[myGate]) {
+                    change(myGate, myValue);
+                }
+            }
+            theLevelEvents[myLevel].clear();
+        }
+    }
+
+    // Puts the signals changed by the last propagation back to their good values
+    void restore(std::vector<Value>& aFaultyState, const Value* aGoodState) {
+        for (int mySignal : theChanged) {
+            aFaultyState[mySignal] = aGoodState[mySignal];
+        }
+        theChanged.clear();
+    }
+
+    // Gate evaluations over all propagations so far
+    long theNumEvaluations;
+
+private:
+    // Gates scheduled for re-evaluation, bucketed by level, and every signal the current propagation changed
+    std::vector<std::vector<int>> theLevelEvents;
+    std::vector<std::uint8_t> theScheduled;
+    std::vector<int> theChanged;
+};
+
+
+// Netlist view of a CircuitTopology for the event propagator
+struct TopologyNetlist {
+    const CircuitTopology& theTopology;
+
+    int getLevel(int aSignal) const { return theTopology.theLevels[aSignal]; }
+
+    template <typename Visitor>
+    void forEachFanout(int aSignal, Visitor aVisit) const {
+        for (const int* myFanout = theTopology.fanoutBegin(aSignal); myFanout != theTopology.fanoutEnd(aSignal); myFanout++) {
+            aVisit(*myFanout);
+        }
+    }
+};
+
+// Single-pattern fault simulator on the compiled netlist of the full-scan core, used to drop faults during ATPG
+// The fault-free machine is simulated once per test; each fault then only re-evaluates the gates of its fanout cone
+// whose inputs changed, level by level, until the difference dies out or reaches an output
+class FaultSimulator {
+public:
+    FaultSimulator(std::shared_ptr<const CircuitTopology> aTopology);
+
+    // Fault-free simulation of a fully specified test, one value per circuit input
+    void simulateGood(const std::vector<SignalType>& aTestVector);
+
+    // Whether the simulated test detects the signal stuck at the opposite of its activation value (fault value D or D_b)
+    bool detects(int aFaultLocation, SignalType aFaultValue);
+
+    std::shared_ptr<const CircuitTopology> theTopology;
+
+private:
+    std::vector<std::uint8_t> theGoodValues;
+    std::vector<std::uint8_t> theFaultyValues;
+    EventPropagator<std::uint8_t> thePropagator;
+
+    std::uint8_t evaluate(int aGate, const std::vector<std::uint8_t>& aValues) const;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#include "learn.h"
+
+
+// Dominators and learned implications are built on construction, and timed together as preprocessing
+StaticLearning::StaticLearning(std::shared_ptr<const CircuitTopology> aTopology) :
+        theTopology(aTopology),
+        thePreprocessingTime(0.0),
+        theValues(aTopology->getNumSignals(), SignalType::X),
+        theForwardImplied(aTopology->getNumSignals(), 0),
+        theQueueHead(0),
+        theConeStamps(aTopology->getNumSignals(), 0),
+        theConeEpoch(0) {
+
+    auto myPreprocessingStart = std::chrono::steady_clock::now();
+
+    build_dominators();
+    learn_implications();
+
+    thePreprocessingTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - myPreprocessingStart).count();
+    std::cout << "Info: Static learning | " << getNumLearned() << " learned implications in " << std::fixed << std::setprecision(6) << thePreprocessingTime << " s" << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+
+// Dominators toward the outputs in reverse topological order - the immediate dominator of a signal is where the
+// dominator chains of its observable fanouts meet, and a chain climbs strictly up the topological order
+void StaticLearning::build_dominators() {
+    const CircuitTopology& myTopology = *theTopology;
+    theDominators = std::vector<int>(myTopology.getNumSignals(), -1);
+
+    std::vector<int> myOrderIdx = std::vector<int>(myTopology.getNumSignals());
+    for (std::size_t myOrderPos = 0; myOrderPos < myTopology.theTopologicalOrder.size(); myOrderPos++) {
+        myOrderIdx[myTopology.theTopologicalOrder[myOrderPos]] = myOrderPos;
+    }
+    auto intersect = [&](int a, int b) {
+        while (a != b && a >= 0 && b >= 0) {
+            if (myOrderIdx[a] < myOrderIdx[b]) {
+                a = theDominators[a];
+            } else {
+                b = theDominators[b];
+            }
+        }
+        return (a == b) ? a : -1;
+    };
+
+    for (auto mySignalIter = myTopology.theTopologicalOrder.rbegin(); mySignalIter != myTopology.theTopologicalOrder.rend(); mySignalIter++) {
+        int mySignal = *mySignalIter;
+        if (myTopology.theIsOutput[mySignal]) {
+            continue;
+        }
+        int myDominator = -1;
+        bool myFirstFanout = true;
+        for (const int* myFanout = myTopology.fanoutBegin(mySignal); myFanout != myTopology.fanoutEnd(mySignal); myFanout++) {
+            if (myTopology.theCO[*myFanout] >= SCOAP_INFINITY) {
+                continue;
+            }
+            myDominator = myFirstFanout ? *myFanout : intersect(myDominator, *myFanout);
+            myFirstFanout = false;
+        }
+        theDominators[mySignal] = myDominator;
+    }
+}
+
+
+// Implies s = v for every signal and value. When that forward implies t = w on a multi-input gate where w needs every
+// input non-controlling, the contrapositive t = !w => s = !v is learned - it has no direct backward implication to
+// rediscover it from, since t = !w only says that some input is controlling
+void StaticLearning::learn_implications() {
+    const CircuitTopology& myTopology = *theTopology;
+    const int myNumLiterals = 2 * myTopology.getNumSignals();
+
+    std::vector<std::pair<int, int>> myLearned = std::vector<std::pair<int, int>>();
+    for (int mySignal = 0; mySignal < myTopology.getNumSignals(); mySignal++) {
+        for (SignalType myValue : {SignalType::ZERO, SignalType::ONE}) {
+            clear();
+            if (!assign(mySignal, myValue, false) || !propagate(false)) {
+                continue;
+            }
+            for (std::size_t myAssignedIdx = 1; myAssignedIdx < theAssigned.size(); myAssignedIdx++) {
+                int myImplied = theAssigned[myAssignedIdx];
+                GateType myGateType = myTopology.theGateTypes[myImplied];
+                if (!theForwardImplied[myImplied] || myTopology.faninEnd(myImplied) - myTopology.faninBegin(myImplied) < 2) {
+                    continue;
+                }
+                SignalType myNonControlledOutput;
+                if (myGateType == GateType::AND || myGateType == GateType::NOR) {
+                    myNonControlledOutput = SignalType::ONE;
+                } else if (myGateType == GateType::NAND || myGateType == GateType::OR) {
+                    myNonControlledOutput = SignalType::ZERO;
+                } else {
+                    continue;
+                }
+                if (theValues[myImplied] == myNonControlledOutput) {
+                    myLearned.push_back(std::pair<int, int>(getLiteral(myImplied, opNOT[myNonControlledOutput]), getLiteral(mySignal, opNOT[myValue])));
+                }
+            }
+        }
+    }
+    clear();
+
+    // Counting sort by the literal each implication follows from
+    theLearnedOffsets = std::vector<int>(myNumLiterals + 1, 0);
+    for (auto& myImplication : myLearned) {
+        theLearnedOffsets[myImplication.first + 1]++;
+    }
+    for (int myLiteral = 0; myLiteral < myNumLiterals; myLiteral++) {
+        theLearnedOffsets[myLiteral + 1] += theLearnedOffsets[myLiteral];
+    }
+    theLearnedLiterals = std::vector<int>(myLearned.size());
+    std::vector<int> myLearnedFill = std::vector<int>(theLearnedOffsets.begin(), theLearnedOffsets.end() - 1);
+    for (auto& myImplication : myLearned) {
+        theLearnedLiterals[myLearnedFill[myImplication.first]++] = myImplication.second;
+    }
+}
+
+
+bool StaticLearning::getNecessaryAssignments(int aFaultLocation, SignalType aFaultValue, std::vector<std::pair<int, SignalType>>& anAssignments) {
+    const CircuitTopology& myTopology = *theTopology;
+    anAssignments.clear();
+    clear();
+
+    bool myConsistent = assign(aFaultLocation, (aFaultValue == SignalType::D) ? SignalType::ONE : SignalType::ZERO, false);
+
+    // Unique sensitization - every path from the fault site runs through its dominators, so their side inputs outside
+    // the fault's fanout cone must be non-controlling in both machines
+    // Inside the site's fanout-free region the path itself is the whole cone, beyond it the cone is marked once
+    int myPathSignal = aFaultLocation;
+    bool myConeMarked = false;
+    for (int myDominator = theDominators[aFaultLocation]; myConsistent && myDominator >= 0; myDominator = theDominators[myDominator]) {
+        if (!myConeMarked && myTopology.fanoutEnd(myPathSignal) - myTopology.fanoutBegin(myPathSignal) != 1) {
+            mark_cone(aFaultLocation);
+            myConeMarked = true;
+        }
+        GateType myGateType = myTopology.theGateTypes[myDominator];
+        if (myGateType == GateType::AND || myGateType == GateType::NAND || myGateType == GateType::OR || myGateType == GateType::NOR) {
+            SignalType myNonControllingValue = (myGateType == GateType::AND || myGateType == GateType::NAND) ? SignalType::ONE : SignalType::ZERO;
+            for (const int* myFanin = myTopology.faninBegin(myDominator); myConsistent && myFanin != myTopology.faninEnd(myDominator); myFanin++) {
+                bool myInCone = myConeMarked ? theConeStamps[*myFanin] == theConeEpoch : *myFanin == myPathSignal;
+                if (!myInCone) {
+                    myConsistent = assign(*myFanin, myNonControllingValue, false);
+                }
+            }
+        }
+        myPathSignal = myDominator;
+    }
+
+    myConsistent = myConsistent && propagate(true);
+    if (myConsistent) {
+        anAssignments.reserve(theAssigned.size());
+        for (int mySignal : theAssigned) {
+            anAssignments.push_back(std::pair<int, SignalType>(mySignal, theValues[mySignal]));
+        }
+    }
+    clear();
+    return myConsistent;
+}
+
+
+// Assigns a good-machine value, returning false if the signal already holds the opposite one
+bool StaticLearning::assign(int aSignal, SignalType aValue, bool anIsForward) {
+    if (theValues[aSignal] == SignalType::X) {
+        theValues[aSignal] = aValue;
+        theForwardImplied[aSignal] = anIsForward;
+        theAssigned.push_back(aSignal);
+        return true;
+    }
+    return theValues[aSignal] == aValue;
+}
+
+
+// Direct implications of a gate in both directions - its output from known inputs, and its inputs from a known output
+// Returns false on a conflict
+bool StaticLearning::implyGate(int aGate) {
+    const CircuitTopology& myTopology = *theTopology;
+    const GateType myGateType = myTopology.theGateTypes[aGate];
+    const int* myFanins = myTopology.faninBegin(aGate);
+    const int* myFaninsEnd = myTopology.faninEnd(aGate);
+    const SignalType myOutputValue = theValues[aGate];
+
+    if (myGateType == GateType::INPUT || myFanins == myFaninsEnd) {
+        return true;
+    }
+
+    switch (myGateType) {
+    case GateType::BUFF:
+    case GateType::NOT: {
+        SignalType myInputValue = theValues[myFanins[0]];
+        bool myInverting = myGateType == GateType::NOT;
+        if (myInputValue != SignalType::X) {
+            return assign(aGate, myInverting ? opNOT[myInputValue] : myInputValue, true);
+        }
+        if (myOutputValue != SignalType::X) {
+            return assign(myFanins[0], myInverting ? opNOT[myOutputValue] : myOutputValue, false);
+        }
+        return true;
+    }
+    case GateType::AND:
+    case GateType::NAND:
+    case GateType::OR:
+    case GateType::NOR: {
+        const SignalType myControllingValue = (myGateType == GateType::AND || myGateType == GateType::NAND) ? SignalType::ZERO : SignalType::ONE;
+        const SignalType myControlledOutput = (myGateType == GateType::NAND || myGateType == GateType::NOR) ? opNOT[myControllingValue] : myControllingValue;
+        bool myHasControllingInput = false;
+        int myNumXInputs = 0;
+        int myXInput = -1;
+        for (const int* myFanin = myFanins; myFanin != myFaninsEnd; myFanin++) {
+            SignalType myInputValue = theValues[*myFanin];
+            if (myInputValue == myControllingValue) {
+                myHasControllingInput = true;
+            } else if (myInputValue == SignalType::X) {
+                myNumXInputs++;
+                myXInput = *myFanin;
+            }
+        }
+        if (myHasControllingInput) {
+            return assign(aGate, myControlledOutput, true);
+        }
+        if (myNumXInputs == 0) {
+            return assign(aGate, opNOT[myControlledOutput], true);
+        }
+        // Non-controlled output needs every input non-controlling, a controlled one with a single X input needs that input
+        if (myOutputValue == opNOT[myControlledOutput]) {
+            for (const int* myFanin = myFanins; myFanin != myFaninsEnd; myFanin++) {
+                if (!assign(*myFanin, opNOT[myControllingValue], false)) {
+                    return false;
+                }
+            }
+        } else if (myOutputValue == myControlledOutput && myNumXInputs == 1) {
+            return assign(myXInput, myControllingValue, false);
+        }
+        return true;
+    }
+    case GateType::XOR:
+    case GateType::XNOR: {
+        bool myParity = myGateType == GateType::XNOR;
+        int myNumXInputs = 0;
+        int myXInput = -1;
+        for (const int* myFanin = myFanins; myFanin != myFaninsEnd; myFanin++) {
+            SignalType myInputValue = theValues[*myFanin];
+            if (myInputValue == SignalType::X) {
+                myNumXInputs++;
+                myXInput = *myFanin;
+            } else {
+                myParity ^= (myInputValue == SignalType::ONE);
+            }
+        }
+        if (myNumXInputs == 0) {
+            return assign(aGate, myParity ? SignalType::ONE : SignalType::ZERO, true);
+        }
+        if (myNumXInputs == 1 && myOutputValue != SignalType::X) {
+            return assign(myXInput, (myParity != (myOutputValue == SignalType::ONE)) ? SignalType::ONE : SignalType::ZERO, false);
+        }
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+
+// Implies every pending assignment to a fixpoint, through the gate driving each signal, its fanouts and (optionally)
+// the learned implications; returns false on a conflict
+bool StaticLearning::propagate(bool aUseLearned) {
+    const CircuitTopology& myTopology = *theTopology;
+    while (theQueueHead < theAssigned.size()) {
+        int mySignal = theAssigned[theQueueHead++];
+        if (!implyGate(mySignal)) {
+            return false;
+        }
+        for (const int* myFanout = myTopology.fanoutBegin(mySignal); myFanout != myTopology.fanoutEnd(mySignal); myFanout++) {
+            if (!implyGate(*myFanout)) {
+                return false;
+            }
+        }
+        if (aUseLearned) {
+            int myLiteral = getLiteral(mySignal, theValues[mySignal]);
+            for (int myLearnedIdx = theLearnedOffsets[myLiteral]; myLearnedIdx < theLearnedOffsets[myLiteral + 1]; myLearnedIdx++) {
+                if (!assign(getLiteralSignal(theLearnedLiterals[myLearnedIdx]), getLiteralValue(theLearnedLiterals[myLearnedIdx]), false)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+// Stamps every signal reachable from the given one
+void StaticLearning::mark_cone(int aSignal) {
+    const CircuitTopology& myTopology = *theTopology;
+    if (++theConeEpoch == INT_MAX) {
+        std::fill(theConeStamps.begin(), theConeStamps.end(), 0);
+        theConeEpoch = 1;
+    }
+    theConeStamps[aSignal] = theConeEpoch;
+    theConeStack.assign(1, aSignal);
+    while (!theConeStack.empty()) {
+        int mySignal = theConeStack.back();
+        theConeStack.pop_back();
+        for (const int* myFanout = myTopology.fanoutBegin(mySignal); myFanout != myTopology.fanoutEnd(mySignal); myFanout++) {
+            if (theConeStamps[*myFanout] != theConeEpoch) {
+                theConeStamps[*myFanout] = theConeEpoch;
+                theConeStack.push_back(*myFanout);
+            }
+        }
+    }
+}
+
+
+// Returns every assigned signal to X
+void StaticLearning::clear() {
+    for (int mySignal : theAssigned) {
+        theValues[mySignal] = SignalType::X;
+    }
+    theAssigned.clear();
+    theQueueHead = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef LEARN_H
+#define LEARN_H
+
+#include "cframe.h"
+
+// Literal of a good-machine assignment - signal s at value v (ZERO or ONE) is 2 * s + v
+inline int getLiteral(int aSignal, SignalType aValue) { return 2 * aSignal + (aValue == SignalType::ONE); }
+inline int getLiteralSignal(int aLiteral) { return aLiteral >> 1; }
+inline SignalType getLiteralValue(int aLiteral) { return (aLiteral & 1) ? SignalType::ONE : SignalType::ZERO; }
+
+// SOCRATES-style static learning and output dominators, computed once per topology before ATPG
+// Both feed the necessary assignments of a fault, which bound its search before the first decision is made
+class StaticLearning {
+public:
+    StaticLearning(std::shared_ptr<const CircuitTopology> aTopology);
+
+    // Good-machine values every test for the fault has to produce: the activation value, the non-controlling value
+    // on each side input of the gates dominating the fault site, and all they imply
+    // Returns false if these conflict, which proves the fault untestable
+    bool getNecessaryAssignments(int aFaultLocation, SignalType aFaultValue, std::vector<std::pair<int, SignalType>>& anAssignments);
+
+    int getNumLearned() const { return theLearnedLiterals.size(); }
+
+    std::shared_ptr<const CircuitTopology> theTopology;
+
+    // Immediate dominator of each signal - the closest gate every path from it to an output runs through
+    // (-1 if there is none, e.g. at the outputs). Inside a fanout-free region this is the only fanout.
+    std::vector<int> theDominators;
+
+    // Learned implications in CSR form, indexed by the literal they follow from
+    std::vector<int> theLearnedOffsets;
+    std::vector<int> theLearnedLiterals;
+
+    // Wall time spent building the dominators and learning, in seconds
+    double thePreprocessingTime;
+
+private:
+    // Three-valued good-machine implication scratch - every assignment is logged so clearing costs only what was assigned
+    std::vector<SignalType> theValues;
+    std::vector<std::uint8_t> theForwardImplied;
+    std::vector<int> theAssigned;
+    std::size_t theQueueHead;
+
+    // Fanout cone of the current fault site - a signal is in it when its stamp equals the epoch
+    std::vector<int> theConeStamps;
+    int theConeEpoch;
+    std::vector<int> theConeStack;
+
+    bool assign(int aSignal, SignalType aValue, bool anIsForward);
+    bool implyGate(int aGate);
+    bool propagate(bool aUseLearned);
+    void clear();
+    void mark_cone(int aSignal);
+
+    void build_dominators();
+    void learn_implications();
+};
+
+#endif
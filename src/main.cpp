@@ -17,6 +17,8 @@
 
 #include "cframe.h"
 #include "podem.h"
+#include "learn.h"
+#include "fsim.h"
 
 // Global counter of total threads running
 int MAX_THREADS;
@@ -24,12 +26,39 @@ char PARALLEL_MODE;
 
 int MAX_ACTIVE_TASKS;
 int MAX_PARALLEL_OBJECTIVES;
-
-bool theSolutionFound = false;
-int theTaskCnt = 0;
+int MAX_FRAMES = 0;
+char DFRONTIER_ORDER = '0';
+char PODEM_HEURISTIC = 'f';
+
+std::atomic<bool> theSolutionFound = false;
+bool X_PATH_CHECK = true;
+bool STATIC_LEARNING = false;
+bool LEARNING_BASELINE = false;
+bool FAULT_COLLAPSING = true;
+bool FAULT_DROPPING = true;
+long BACKTRACK_LIMIT = 0;
+long theBacktrackCnt = 0;
+long theXPathPruneCnt = 0;
+long theLearningPruneCnt = 0;
+long theImpliedInputCnt = 0;
+long theDecisionCnt = 0;
+int theLearnedUntestableCnt = 0;
+int theTargetedFaultCnt = 0;
+int theDroppedFaultCnt = 0;
+int theUntestableFaultCnt = 0;
+int theAbortedFaultCnt = 0;
+std::atomic<int> theTaskCnt = 0;
 int theMaxTaskCnt = 0;
+long theStealCnt = 0;
+long theWastedDecisionCnt = 0;
+int theSolvedSearchCnt = 0;
+double theFirstSolutionTime = 0;
+double theCancellationTime = 0;
 double theTotalComputationTime = 0;
 
+// Static learning of the full-scan core, shared by every fault (null when disabled)
+std::unique_ptr<StaticLearning> theStaticLearning;
+
 
 // Print usage information
 void usage(const char* progname) {
@@ -37,15 +66,24 @@ void usage(const char* progname) {
     printf("Program Options:\n");
     printf("  -b  --bench <FILE>                  Run specified function on input\n");
     printf("  -t  --max_threads <INT>             Number of threads to use\n");
-    printf("  -a  --max_active_tasks <INT>        Number of active tasks to use\n");
+    printf("  -a  --max_active_tasks <INT>        Number of active tasks to use when parallelizing across signals\n");
     printf("  -o  --max_parallel_objectives <INT> Number of parallel objectives when parallelizing across decisions\n");
-    printf("  -m  --parallel_mode <char>          's' or 'd' parallelize across decisions or signals\n");
+    printf("  -m  --parallel_mode <char>          's', 'd' or 'f' parallelize across signals, decisions or faults\n");
+    printf("  -f  --max_frames <INT>              Unroll flip-flops over up to INT time frames instead of using full scan (optional)\n");
+    printf("  -e  --heuristic <char>              'f' first X input or 's' SCOAP-guided backtrace and objectives (optional)\n");
+    printf("  -d  --dfrontier_order <char>        'i' lowest signal ID, 'l' highest level or 'o' most observable D-frontier gate first\n");
+    printf("                                      (optional, defaults to 'o' with SCOAP and 'i' otherwise)\n");
+    printf("  -x  --xpath_check <0|1>             Prune search nodes without an X-path to an output (optional, default 1)\n");
+    printf("  -l  --static_learning <0|1|2>       Static learning and dominator preprocessing for full-scan ATPG, 2 also times the search without it (optional, default 0)\n");
+    printf("  -c  --collapse <0|1>                Equivalence and dominance fault collapsing for full-scan ATPG (optional, default 1)\n");
+    printf("  -r  --fault_dropping <0|1>          Fault simulate every new test and drop the faults it detects (optional, default 1)\n");
+    printf("  -k  --backtrack_limit <INT>         Abort a fault after INT backtracks, 0 for no limit (optional, default 0)\n");
     printf("  -?  --help                          This message\n");
 }
 
 
 // Line parser for string splitting
-static std::vector<std::string> tokenize_line(std::string s) {
+static std::vector<std::string> tokenize_file_name(std::string s) {
     std::ranges::replace(s, '/', ' ');
     std::ranges::replace(s, '.', ' ');
 
@@ -61,105 +99,500 @@ static std::vector<std::string> tokenize_line(std::string s) {
 }
 
 
+// Gate order the D-frontier is visited in, for the order selected on the command line (empty for ascending ID)
+std::vector<int> getDFrontierOrder(const CircuitTopology& aTopology) {
+    char myOrder = DFRONTIER_ORDER;
+    if (myOrder == '0') {
+        myOrder = (PODEM_HEURISTIC == 's' || PODEM_HEURISTIC == 'S') ? 'o' : 'i';
+    }
+
+    std::vector<int> myGateOrder = std::vector<int>();
+    if (myOrder == 'i' || myOrder == 'I') {
+        return myGateOrder;
+    }
+
+    // Ties are broken by ID so every run sees the same order
+    myGateOrder = std::vector<int>(aTopology.getNumSignals());
+    for (int mySignal = 0; mySignal < aTopology.getNumSignals(); mySignal++) {
+        myGateOrder[mySignal] = mySignal;
+    }
+    if (myOrder == 'l' || myOrder == 'L') {
+        // Closest to the outputs first
+        std::stable_sort(myGateOrder.begin(), myGateOrder.end(), [&](int a, int b) { return aTopology.theLevels[a] > aTopology.theLevels[b]; });
+    } else {
+        // Easiest to observe (lowest SCOAP observability) first
+        std::stable_sort(myGateOrder.begin(), myGateOrder.end(), [&](int a, int b) { return aTopology.theCO[a] < aTopology.theCO[b]; });
+    }
+    return myGateOrder;
+}
+
+
+// Clears the search statistics, so a baseline run does not count towards the reported one
+static void resetStatistics() {
+    theBacktrackCnt = theXPathPruneCnt = theLearningPruneCnt = theImpliedInputCnt = theDecisionCnt = 0;
+    theLearnedUntestableCnt = theTargetedFaultCnt = theDroppedFaultCnt = theUntestableFaultCnt = theAbortedFaultCnt = 0;
+    theMaxTaskCnt = theSolvedSearchCnt = 0;
+    theStealCnt = theWastedDecisionCnt = 0;
+    theFirstSolutionTime = theCancellationTime = 0.0;
+}
+
+
+// Whether faults rather than the decisions of one fault are spread over the threads
+static bool isFaultParallel() {
+    return PARALLEL_MODE == 'f' || PARALLEL_MODE == 'F';
+}
+
+
 // Initiates the recursive PODEM algorithm based on parallization strategy
-std::unique_ptr<std::unordered_map<std::string, SignalType>> startPODEM(Circuit& aCircuit, std::pair<std::string, SignalType> anSSLFault){
+// The learning is passed in since its scratch state belongs to one thread at a time (null when disabled)
+// A failed search is reported aborted when it ran into the backtrack limit rather than proving the fault untestable
+std::unique_ptr<std::vector<SignalType>> startPODEM(Circuit& aCircuit, std::pair<int, SignalType> anSSLFault, StaticLearning* aStaticLearning, bool& anIsAborted){
     // Set fault and initialize counters
     aCircuit.setCircuitFault(anSSLFault.first, anSSLFault.second);
+    anIsAborted = false;
+
+    // Necessary assignments bound the search, and a conflict among them proves the fault untestable without one
+    if (aStaticLearning && !aCircuit.isUnrolled()) {
+        std::vector<std::pair<int, SignalType>> myNecessaryAssignments = std::vector<std::pair<int, SignalType>>();
+        if (!aStaticLearning->getNecessaryAssignments(anSSLFault.first, anSSLFault.second, myNecessaryAssignments)) {
+            #pragma omp atomic
+            theLearnedUntestableCnt++;
+            return NULL;
+        }
+        aCircuit.setRequiredValues(myNecessaryAssignments);
+    }
+
     aCircuit.resetCircuit();
+
+    // Necessary values on decision inputs hold in every test, so the search starts from them as decisions without an
+    // alternative; the rest of the necessary assignments only prune
+    std::vector<std::pair<int, SignalType>> myDecisions = std::vector<std::pair<int, SignalType>>();
+    for (auto& myRequiredValue : aCircuit.getRequiredValues()) {
+        if (aCircuit.isDecisionInput(myRequiredValue.first)) {
+            myDecisions.push_back(myRequiredValue);
+        }
+    }
+    #pragma omp atomic
+    theImpliedInputCnt += myDecisions.size();
+
+    // Fault-parallel threads each search their own fault serially, already inside the parallel region
+    if (isFaultParallel()) {
+        aCircuit.syncDecisions(myDecisions);
+        std::vector<SignalType> myTestVector = runPODEMRecursiveSerial(aCircuit);
+        anIsAborted = myTestVector.empty() && isAborted(aCircuit);
+        return myTestVector.empty() ? NULL : std::make_unique<std::vector<SignalType>>(myTestVector);
+    }
+
     theSolutionFound = false;
     theTaskCnt = 0;
     theMaxTaskCnt = 0;
 
-   std::unordered_map<std::string, SignalType> myTestVector;
-    #pragma omp parallel
-    #pragma omp single
-    {
-        // std::cout << "Coordinator Thread " << omp_get_thread_num() << std::endl;
-        if (PARALLEL_MODE == 's' || PARALLEL_MODE == 'S'){
-            myTestVector = runPODEMRecursiveParallelSignals(aCircuit);
-        } else if (PARALLEL_MODE == 'd' || PARALLEL_MODE == 'D') {
-            myTestVector = runPODEMRecursiveParallelDecisions(aCircuit);
-        } else {
-            myTestVector = runPODEMRecursiveSerial(aCircuit);
+    // Parallel modes search on per-thread circuits that start from the implied decision path
+    bool myParallelSearch = (PARALLEL_MODE == 's' || PARALLEL_MODE == 'S' || PARALLEL_MODE == 'd' || PARALLEL_MODE == 'D');
+    if (myParallelSearch) {
+        prepareWorkerCircuits(aCircuit);
+    }
+
+    std::vector<SignalType> myTestVector;
+    if (PARALLEL_MODE == 'd' || PARALLEL_MODE == 'D') {
+        // The work-stealing scheduler runs its own parallel region
+        myTestVector = runPODEMWorkStealing(myDecisions);
+    } else {
+        #pragma omp parallel
+        #pragma omp single
+        {
+            // std::cout << "Coordinator Thread " << omp_get_thread_num() << std::endl;
+            if (PARALLEL_MODE == 's' || PARALLEL_MODE == 'S'){
+                myTestVector = runPODEMRecursiveParallelSignals(myDecisions);
+            } else {
+                aCircuit.syncDecisions(myDecisions);
+                myTestVector = runPODEMRecursiveSerial(aCircuit);
+            }
         }
     }
 
     // Return ATPG success or failure
     if (!myTestVector.empty()) {
-        return std::make_unique<std::unordered_map<std::string, SignalType>>(myTestVector);
+        return std::make_unique<std::vector<SignalType>>(myTestVector);
     } else {
+        anIsAborted = myParallelSearch ? isWorkerSearchAborted() : isAborted(aCircuit);
         return NULL;
     }
 }
 
 
-// Begin ATPG on given circuit and return comprehensive results
-std::vector<std::tuple<std::pair<std::string, SignalType>, double, std::unordered_map<std::string, SignalType>>> runATPG(Circuit& aCircuit) {
+// Appends the value of each listed signal to a pattern field, one character per signal
+static void appendPatternBits(std::string& aField, const Circuit& aCircuit, const std::vector<int>& aSignals, std::size_t aBegin, std::size_t anEnd) {
+    for (std::size_t mySignalIdx = aBegin; mySignalIdx < anEnd; mySignalIdx++) {
+        SignalType myValue = aCircuit.getSignalState(aSignals[mySignalIdx]);
+        aField += (myValue == SignalType::ZERO ? '0' : (myValue == SignalType::ONE ? '1' : 'X'));
+    }
+}
 
-    double myTotalComputationTime = 0.0;
 
-    // Unique_ptr to vector of results for each SSL fault ATPG
-    // Each result entry consists of: | SSL fault (pair of string and SignalType) | Computation type (double) | Generated Test Vector (Unordered map of input signal names and values) - return empty map if SSL fault undetectable |
-    std::vector<std::tuple<std::pair<std::string, SignalType>, double, std::unordered_map<std::string, SignalType>>> myATPGData = std::vector<std::tuple<std::pair<std::string, SignalType>, double, std::unordered_map<std::string, SignalType>>>();
+// Write each test of a full-scan design as a scan pattern: primary inputs, scan load, then the fault-free
+// primary outputs and scan unload the tester should expect (X where the test leaves them unknown)
+void writeScanPatterns(const Circuit& aCircuit, const std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>>& anATPGData, const std::string& aPatternFileName) {
+    std::ofstream myPatternFile(aPatternFileName);
+    if (!myPatternFile) {
+        std::cout << "Error: Unable to open scan pattern file for writing" << std::endl;
+        return;
+    }
+
+    const CircuitTopology& myTopology = *aCircuit.theTopology;
+    const std::size_t myNumPrimaryInputs = myTopology.getNumPrimaryInputs();
+    const std::size_t myNumPrimaryOutputs = myTopology.getNumPrimaryOutputs();
+
+    // Scan chain order, shared by the load and unload fields
+    myPatternFile << "# scan_cells";
+    for (int myCell = 0; myCell < myTopology.theNumScanCells; myCell++) {
+        myPatternFile << "," << myTopology.theSignalNames[myTopology.getPresentState(myCell)];
+    }
+    myPatternFile << std::endl;
+    myPatternFile << "# fault,sa,pi,scan_load,po,scan_unload" << std::endl;
+
+    // Good machine simulation of each test on a fault-free circuit
+    Circuit myGoodCircuit = Circuit(aCircuit.theTopology);
+    for (auto& [mySSLFault, myTime, myTestVector] : anATPGData) {
+        if (myTestVector.empty()) {
+            continue;
+        }
+        myGoodCircuit.resetCircuit();
+        for (std::size_t myInputIdx = 0; myInputIdx < myTestVector.size(); myInputIdx++) {
+            if (myTestVector[myInputIdx] != SignalType::X) {
+                myGoodCircuit.setAndImplyCircuitInput(myTopology.theCircuitInputs[myInputIdx], myTestVector[myInputIdx]);
+            }
+        }
+
+        std::string myPattern = myTopology.theSignalNames[mySSLFault.first] + "," + (mySSLFault.second == SignalType::D ? '0' : '1') + ",";
+        appendPatternBits(myPattern, myGoodCircuit, myTopology.theCircuitInputs, 0, myNumPrimaryInputs);
+        myPattern += ",";
+        appendPatternBits(myPattern, myGoodCircuit, myTopology.theCircuitInputs, myNumPrimaryInputs, myTopology.theCircuitInputs.size());
+        myPattern += ",";
+        appendPatternBits(myPattern, myGoodCircuit, myTopology.theCircuitOutputs, 0, myNumPrimaryOutputs);
+        myPattern += ",";
+        appendPatternBits(myPattern, myGoodCircuit, myTopology.theCircuitOutputs, myNumPrimaryOutputs, myTopology.theCircuitOutputs.size());
+        myPatternFile << myPattern << std::endl;
+    }
+}
+
+
+// Run PODEM on one fault and report the outcome
+std::unique_ptr<std::vector<SignalType>> runSingleFault(Circuit& aCircuit, std::pair<int, SignalType> aTargetSSLFault, double& aSingleSSLATPGTime, StaticLearning* aStaticLearning, bool& anIsAborted) {
+    #ifdef DEBUG
+    std::cout << "Info: Running PODEM to detect fault: " << aCircuit.theTopology->theSignalNames[aTargetSSLFault.first] << " | SA: " << (aTargetSSLFault.second == SignalType::D ? '0' : '1') << std::endl;
+    #endif
 
-    std::vector<std::pair<std::string, SignalType>> mySSLFaults = std::vector<std::pair<std::string, SignalType>>();
+    const auto mySingleSSLATPGStartTime = std::chrono::steady_clock::now();
+    std::unique_ptr<std::vector<SignalType>> myTestVector = startPODEM(aCircuit, aTargetSSLFault, aStaticLearning, anIsAborted);
+    aSingleSSLATPGTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - mySingleSSLATPGStartTime).count();
 
-    // Add all possible signal faults
-    std::vector<std::string> myTest = std::vector<std::string>();
-    for (auto& mySignalPair : aCircuit.theCircuit){
-        mySSLFaults.push_back(std::pair<std::string, SignalType>(mySignalPair.first, SignalType::D));
-        mySSLFaults.push_back(std::pair<std::string, SignalType>(mySignalPair.first, SignalType::D_b));
+    #ifdef DEBUG
+    if (myTestVector != NULL){
+        std::cout << "\n--- Found test vector for signal " << aCircuit.theTopology->theSignalNames[aTargetSSLFault.first] << " | SA: " << (aTargetSSLFault.second == SignalType::D ? '0' : '1') << " ---" << std::endl;
+        for (std::size_t myInputIdx = 0; myInputIdx < myTestVector->size(); myInputIdx++){
+            std::cout << std::setw(30) << aCircuit.theTopology->theSignalNames[aCircuit.theTopology->theCircuitInputs[myInputIdx]] << ": " << getSignalStateString((*myTestVector)[myInputIdx]) << std::endl;
+        }
+    } else {
+        std::cout << "Info: Unable to generate test vector for fault: " << aCircuit.theTopology->theSignalNames[aTargetSSLFault.first] << " | SA: " << (aTargetSSLFault.second == SignalType::D ? '0' : '1') << std::endl;
     }
-    // Single test fault
-    // mySSLFaults.push_back(std::pair<std::string, SignalType>("213_BRANCH0_259", SignalType::D));
+    std::cout << "Computation time for single SSL fault ATPG (sec): " << std::fixed << std::setprecision(10) << aSingleSSLATPGTime << '\n';
+    #endif
 
-    std::size_t myNumFaults = mySSLFaults.size();
-    (void) myNumFaults;
+    return myTestVector;
+}
 
-    // Report results
-    while (!mySSLFaults.empty()){
-        std::pair<std::string, SignalType> myTargetSSLFault = mySSLFaults.back();
 
-        #ifdef DEBUG
-        std::cout << "\nProgress: " << (myNumFaults - mySSLFaults.size()) << " / " << myNumFaults << " faults complete" << std::endl;
-        std::cout << "Info: Running PODEM to detect fault: " << myTargetSSLFault.first << " | SA: " << (myTargetSSLFault.second == SignalType::D ? '0' : '1') << std::endl;
-        #endif
+// Outcome of each fault, indexed like the FaultList - a slot is only written by the thread that claimed its fault
+#define FAULT_TARGETED 1
+#define FAULT_DROPPED 2
 
-        const auto mySingleSSLATPGStartTime = std::chrono::steady_clock::now();
-        std::unique_ptr<std::unordered_map<std::string, SignalType>> myTestVector = startPODEM(aCircuit, myTargetSSLFault);
-        const auto mySingleSSLATPGTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - mySingleSSLATPGStartTime).count();
-        myTotalComputationTime += mySingleSSLATPGTime;
+struct FaultResults {
+    FaultResults(int aNumFaults) : theTests(aNumFaults), theTimes(aNumFaults, 0.0), theStates(aNumFaults, 0) {}
 
-        if (myTestVector != NULL){
-            myATPGData.push_back(std::tuple<std::pair<std::string, SignalType>, double, std::unordered_map<std::string, SignalType>>(myTargetSSLFault, mySingleSSLATPGTime, *myTestVector));
+    std::vector<std::unique_ptr<std::vector<SignalType>>> theTests;
+    std::vector<double> theTimes;
+    // FAULT_TARGETED once a thread takes the fault for PODEM, FAULT_DROPPED once the test of another fault detects it
+    // The fault belongs to whichever came first, the later one only sets its bit
+    std::vector<std::uint8_t> theStates;
+};
 
-            #ifdef DEBUG
-            std::cout << "\n--- Found test vector for signal " << myTargetSSLFault.first << " | SA: " << (myTargetSSLFault.second == SignalType::D ? '0' : '1') << " ---" << std::endl;
-            for (auto& [myTestVectorInputSignal, myTestVectorInputValue] : *myTestVector){
-                std::cout << std::setw(30) << myTestVectorInputSignal << ": " << getSignalStateString(myTestVectorInputValue) << std::endl;
+
+// Replace the unassigned inputs of a test by pseudo-random values, seeded so the same fault always gets the same test
+void fillTestVector(std::vector<SignalType>& aTestVector, int aSeed) {
+    std::mt19937 myRandom(aSeed);
+    for (auto& myValue : aTestVector) {
+        if (myValue == SignalType::X) {
+            myValue = (myRandom() & 1) ? SignalType::ONE : SignalType::ZERO;
+        }
+    }
+}
+
+
+// Run PODEM on each listed fault that no earlier test detects, storing its test (null if none) and time at the fault's index
+// With fault dropping every new test is filled and fault simulated against the listed faults still pending, which are
+// then dropped with that test instead of being targeted
+// In fault-parallel mode the faults are handed out one at a time to threads that each own a copy of the search state;
+// a fault is claimed atomically by whichever thread targets or drops it first, and only that thread writes its slot
+void runFaults(Circuit& aCircuit, const std::vector<int>& aFaultIdxs, FaultResults& aResults) {
+    const auto myStartTime = std::chrono::steady_clock::now();
+
+    auto runFault = [&](Circuit& aThreadCircuit, StaticLearning* aThreadLearning, FaultSimulator& aFaultSimulator, std::size_t anIdx) {
+        int myFaultIdx = aFaultIdxs[anIdx];
+        std::uint8_t myState;
+        #pragma omp atomic capture
+        { myState = aResults.theStates[myFaultIdx]; aResults.theStates[myFaultIdx] |= FAULT_TARGETED; }
+        if (myState & FAULT_DROPPED) {
+            return;
+        }
+
+        bool myIsAborted = false;
+        std::unique_ptr<std::vector<SignalType>> myTestVector = runSingleFault(aThreadCircuit, FaultList::getFault(myFaultIdx), aResults.theTimes[myFaultIdx], aThreadLearning, myIsAborted);
+        #pragma omp atomic
+        theTargetedFaultCnt++;
+        if (myTestVector == NULL && myIsAborted) {
+            #pragma omp atomic
+            theAbortedFaultCnt++;
+        } else if (myTestVector == NULL) {
+            #pragma omp atomic
+            theUntestableFaultCnt++;
+        }
+
+        if (myTestVector != NULL && FAULT_DROPPING) {
+            fillTestVector(*myTestVector, myFaultIdx);
+            aFaultSimulator.simulateGood(*myTestVector);
+            // Faults listed before this one are already claimed
+            for (std::size_t myOtherIdx = anIdx + 1; myOtherIdx < aFaultIdxs.size(); myOtherIdx++) {
+                int myOtherFaultIdx = aFaultIdxs[myOtherIdx];
+                std::uint8_t myOtherState;
+                #pragma omp atomic read
+                myOtherState = aResults.theStates[myOtherFaultIdx];
+                std::pair<int, SignalType> myOtherFault = FaultList::getFault(myOtherFaultIdx);
+                if (myOtherState != 0 || !aFaultSimulator.detects(myOtherFault.first, myOtherFault.second)) {
+                    continue;
+                }
+                #pragma omp atomic capture
+                { myOtherState = aResults.theStates[myOtherFaultIdx]; aResults.theStates[myOtherFaultIdx] |= FAULT_DROPPED; }
+                if (myOtherState == 0) {
+                    aResults.theTests[myOtherFaultIdx] = std::make_unique<std::vector<SignalType>>(*myTestVector);
+                    #pragma omp atomic
+                    theDroppedFaultCnt++;
+                }
             }
-            #endif
+        }
+        aResults.theTests[myFaultIdx] = std::move(myTestVector);
+    };
 
-        } else {
-            myATPGData.push_back(std::tuple<std::pair<std::string, SignalType>, double, std::unordered_map<std::string, SignalType>>(myTargetSSLFault, mySingleSSLATPGTime, std::unordered_map<std::string, SignalType>()));
+    if (isFaultParallel()) {
+        #pragma omp parallel
+        {
+            Circuit myThreadCircuit = aCircuit;
+            std::unique_ptr<StaticLearning> myThreadLearning = theStaticLearning ? std::make_unique<StaticLearning>(*theStaticLearning) : nullptr;
+            FaultSimulator myFaultSimulator = FaultSimulator(aCircuit.theTopology);
+
+            #pragma omp for schedule(dynamic, 1)
+            for (std::size_t myIdx = 0; myIdx < aFaultIdxs.size(); myIdx++) {
+                runFault(myThreadCircuit, myThreadLearning.get(), myFaultSimulator, myIdx);
+            }
+        }
+    } else {
+        FaultSimulator myFaultSimulator = FaultSimulator(aCircuit.theTopology);
+        for (std::size_t myIdx = 0; myIdx < aFaultIdxs.size(); myIdx++) {
             #ifdef DEBUG
-            std::cout << "Info: Unable to generate test vector for fault: " << myTargetSSLFault.first << " | SA: " << (myTargetSSLFault.second == SignalType::D ? '0' : '1') << std::endl;
+            std::cout << "\nProgress: " << myIdx << " / " << aFaultIdxs.size() << " faults complete" << std::endl;
             #endif
+            runFault(aCircuit, theStaticLearning.get(), myFaultSimulator, myIdx);
         }
+    }
+
+    theTotalComputationTime += std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - myStartTime).count();
+}
+
+
+// Begin ATPG on given circuit and return comprehensive results
+// With collapsing only one fault per equivalence class is targeted and dominating classes are only targeted when the class
+// they dominate turned out untestable, every other fault takes the outcome of the fault it maps to - results are reported
+// over the full single stuck-at universe either way
+std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>> runATPG(Circuit& aCircuit) {
+
+    theTotalComputationTime = 0.0;
+
+    // Unique_ptr to vector of results for each SSL fault ATPG
+    // Each result entry consists of: | SSL fault (pair of string and SignalType) | Computation type (double) | Generated Test Vector (Unordered map of input signal names and values) - return empty map if SSL fault undetectable |
+    std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>> myATPGData = std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>>();
+
+    const auto myCollapseStartTime = std::chrono::steady_clock::now();
+    FaultList myFaultList = FaultList(*aCircuit.theTopology);
+    const int myNumFaults = myFaultList.getNumFaults();
+    if (!FAULT_COLLAPSING) {
+        myFaultList.theRepresentatives = std::vector<int>(myNumFaults);
+        for (int myFaultIdx = 0; myFaultIdx < myNumFaults; myFaultIdx++) {
+            myFaultList.theRepresentatives[myFaultIdx] = myFaultIdx;
+        }
+        myFaultList.theDominated = std::vector<int>(myNumFaults, -1);
+        myFaultList.theNumClasses = myFaultList.theNumTargets = myNumFaults;
+    } else {
+        const auto myCollapseTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - myCollapseStartTime).count();
+        std::cout << "Info: Fault collapsing | " << myNumFaults << " faults, " << myFaultList.theNumClasses << " equivalence classes, " << myFaultList.theNumTargets << " targets in " << std::fixed << std::setprecision(6) << myCollapseTime << " s" << std::endl;
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+
+    // Outcome of each class representative, filled in on first use
+    FaultResults myClassResults = FaultResults(myNumFaults);
+    std::vector<std::uint8_t> myClassDone(myNumFaults, 0);
+
+    // Targets first, in the order the full fault list used to be run (highest signal ID, stuck-at-1 first)
+    std::vector<int> myFaultIdxs = std::vector<int>();
+    for (int myFaultIdx = myNumFaults - 1; myFaultIdx >= 0; myFaultIdx--) {
+        if (myFaultList.isTarget(myFaultIdx)) {
+            myFaultIdxs.push_back(myFaultIdx);
+            myClassDone[myFaultIdx] = 1;
+        }
+    }
+    runFaults(aCircuit, myFaultIdxs, myClassResults);
+
+    // A test for a dominated class also detects the class dominating it, which is only targeted when there is none
+    // Dominance chains are resolved one link per round, so each round only depends on finished classes
+    int myNumPending = myFaultList.theNumClasses - myFaultList.theNumTargets;
+    while (myNumPending > 0) {
+        myFaultIdxs.clear();
+        std::vector<int> myResolved = std::vector<int>();
+        for (int myFaultIdx = myNumFaults - 1; myFaultIdx >= 0; myFaultIdx--) {
+            if (myFaultList.theRepresentatives[myFaultIdx] != myFaultIdx || myClassDone[myFaultIdx] || !myClassDone[myFaultList.theDominated[myFaultIdx]]) {
+                continue;
+            }
+            const std::unique_ptr<std::vector<SignalType>>& myDominatedTest = myClassResults.theTests[myFaultList.theDominated[myFaultIdx]];
+            if (myDominatedTest != NULL) {
+                myClassResults.theTests[myFaultIdx] = std::make_unique<std::vector<SignalType>>(*myDominatedTest);
+            } else {
+                myFaultIdxs.push_back(myFaultIdx);
+            }
+            myResolved.push_back(myFaultIdx);
+        }
+        runFaults(aCircuit, myFaultIdxs, myClassResults);
+        for (int myFaultIdx : myResolved) {
+            myClassDone[myFaultIdx] = 1;
+        }
+        myNumPending -= myResolved.size();
+    }
+
+    // Report results over the full fault universe
+    for (int myFaultIdx = myNumFaults - 1; myFaultIdx >= 0; myFaultIdx--) {
+        int myClass = myFaultList.theRepresentatives[myFaultIdx];
+        double mySingleSSLATPGTime = (myClass == myFaultIdx) ? myClassResults.theTimes[myClass] : 0.0;
+        myATPGData.push_back(std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>(FaultList::getFault(myFaultIdx), mySingleSSLATPGTime, (myClassResults.theTests[myClass] != NULL) ? *myClassResults.theTests[myClass] : std::vector<SignalType>()));
+    }
+
+    return myATPGData;
+}
+
+
+// Sequential ATPG by time-frame expansion, for designs whose flip-flops are not scanned
+// Each fault is first targeted in a single frame, then the circuit is unrolled one frame further at a time (up to MAX_FRAMES)
+// For k frames the fault is activated in each frame in turn, latest first, so earlier frames justify the state and later ones propagate it
+std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>> runSequentialATPG(std::shared_ptr<const CircuitTopology> aTopology) {
+
+    double myTotalComputationTime = 0.0;
+    const int myNumFrameSignals = aTopology->getNumSignals();
+
+    std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>> myATPGData = std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>>();
+
+    // One unrolled circuit per frame count, all over the same topology
+    std::vector<Circuit> myFrameCircuits = std::vector<Circuit>();
+    const std::vector<int> myGateOrder = getDFrontierOrder(*aTopology);
+    for (int myNumFrames = 1; myNumFrames <= MAX_FRAMES; myNumFrames++) {
+        myFrameCircuits.push_back(Circuit(aTopology, myNumFrames));
+        myFrameCircuits.back().setDFrontierOrder(myGateOrder);
+    }
+    std::vector<int> myFrameTargeted = std::vector<int>(MAX_FRAMES, 0);
+    std::vector<int> myFrameDetected = std::vector<int>(MAX_FRAMES, 0);
+    std::vector<double> myFrameTimes = std::vector<double>(MAX_FRAMES, 0.0);
+
+    std::vector<std::pair<int, SignalType>> mySSLFaults = std::vector<std::pair<int, SignalType>>();
+    for (int mySignal = 0; mySignal < myNumFrameSignals; mySignal++){
+        mySSLFaults.push_back(std::pair<int, SignalType>(mySignal, SignalType::D));
+        mySSLFaults.push_back(std::pair<int, SignalType>(mySignal, SignalType::D_b));
+    }
+
+    while (!mySSLFaults.empty()){
+        std::pair<int, SignalType> myTargetSSLFault = mySSLFaults.back();
 
         #ifdef DEBUG
-        std::cout << "Computation time for single SSL fault ATPG (sec): " << std::fixed << std::setprecision(10) << mySingleSSLATPGTime << '\n';
+        std::cout << "Info: Running sequential PODEM to detect fault: " << aTopology->theSignalNames[myTargetSSLFault.first] << " | SA: " << (myTargetSSLFault.second == SignalType::D ? '0' : '1') << std::endl;
         #endif
 
+        const auto mySingleSSLATPGStartTime = std::chrono::steady_clock::now();
+        std::unique_ptr<std::vector<SignalType>> myTestVector = NULL;
+        for (int myNumFrames = 1; myNumFrames <= MAX_FRAMES && myTestVector == NULL; myNumFrames++) {
+            const auto myFrameStartTime = std::chrono::steady_clock::now();
+            Circuit& myFrameCircuit = myFrameCircuits[myNumFrames - 1];
+            for (int myActivationFrame = myNumFrames - 1; myActivationFrame >= 0 && myTestVector == NULL; myActivationFrame--) {
+                bool myIsAborted = false;
+                myTestVector = startPODEM(myFrameCircuit, std::pair<int, SignalType>(myActivationFrame * myNumFrameSignals + myTargetSSLFault.first, myTargetSSLFault.second), theStaticLearning.get(), myIsAborted);
+            }
+            myFrameTargeted[myNumFrames - 1]++;
+            myFrameDetected[myNumFrames - 1] += (myTestVector != NULL);
+            myFrameTimes[myNumFrames - 1] += std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - myFrameStartTime).count();
+        }
+        const auto mySingleSSLATPGTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - mySingleSSLATPGStartTime).count();
+        myTotalComputationTime += mySingleSSLATPGTime;
+
+        myATPGData.push_back(std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>(myTargetSSLFault, mySingleSSLATPGTime, (myTestVector != NULL) ? *myTestVector : std::vector<SignalType>()));
+
         mySSLFaults.pop_back();
     }
 
+    // Report where the effort went for each frame count
+    std::cout << "\n-------------- Time-Frame Expansion --------------" << std::endl;
+    for (int myNumFrames = 1; myNumFrames <= MAX_FRAMES; myNumFrames++) {
+        std::cout << "Frames: " << myNumFrames << " | Faults targeted: " << myFrameTargeted[myNumFrames - 1] << " | Detected: " << myFrameDetected[myNumFrames - 1]
+                  << " | Time (sec): " << std::fixed << std::setprecision(10) << myFrameTimes[myNumFrames - 1] << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+
     theTotalComputationTime = myTotalComputationTime;
 
     return myATPGData;
 }
 
 
+// Write each test of a sequential design as its clock cycles, one field of primary input values per cycle
+void writeTestSequences(const CircuitTopology& aTopology, const std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>>& anATPGData, const std::string& aSequenceFileName) {
+    std::ofstream mySequenceFile(aSequenceFileName);
+    if (!mySequenceFile) {
+        std::cout << "Error: Unable to open test sequence file for writing" << std::endl;
+        return;
+    }
+
+    const std::size_t myNumPrimaryInputs = aTopology.getNumPrimaryInputs();
+    std::size_t myNumTests = 0;
+    std::size_t myNumCycles = 0;
+
+    mySequenceFile << "# fault,sa,cycles,pi@0,pi@1,..." << std::endl;
+    for (auto& [mySSLFault, myTime, myTestVector] : anATPGData) {
+        if (myTestVector.empty()) {
+            continue;
+        }
+        std::size_t myCycles = myTestVector.size() / myNumPrimaryInputs;
+        mySequenceFile << aTopology.theSignalNames[mySSLFault.first] << "," << (mySSLFault.second == SignalType::D ? '0' : '1') << "," << myCycles;
+        for (std::size_t myInputIdx = 0; myInputIdx < myTestVector.size(); myInputIdx++) {
+            if (myInputIdx % myNumPrimaryInputs == 0) {
+                mySequenceFile << ",";
+            }
+            mySequenceFile << (myTestVector[myInputIdx] == SignalType::ZERO ? '0' : (myTestVector[myInputIdx] == SignalType::ONE ? '1' : 'X'));
+        }
+        mySequenceFile << std::endl;
+        myNumTests++;
+        myNumCycles += myCycles;
+    }
+
+    if (myNumTests > 0) {
+        std::cout << "Info: " << myNumTests << " test sequences, " << std::fixed << std::setprecision(2) << (static_cast<double>(myNumCycles) / myNumTests) << " cycles per test on average" << std::endl;
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+}
+
+
 int main(int argc, char** argv) {
 
     // parse commandline options ////////////////////////////////////////////
@@ -170,29 +603,68 @@ int main(int argc, char** argv) {
         {"max_active_tasks", 1, 0, 'a'},
         {"max_parallel_objectives", 1, 0, 'o'},
         {"parallel_mode",    1, 0, 'm'},
+        {"max_frames",       1, 0, 'f'},
+        {"dfrontier_order",  1, 0, 'd'},
+        {"heuristic",        1, 0, 'e'},
+        {"xpath_check",      1, 0, 'x'},
+        {"static_learning",  1, 0, 'l'},
+        {"collapse",         1, 0, 'c'},
+        {"fault_dropping",   1, 0, 'r'},
+        {"backtrack_limit",  1, 0, 'k'},
         {"help",             0, 0, '?'},
         {0 ,0, 0, 0}
     };
 
     std::string myCircuitFile;
     PARALLEL_MODE = '0';
+    int myNumRequiredOptions = 0;
 
-    while ((opt = getopt_long(argc, argv, "b:t:a:o:m:?", long_options, NULL)) != EOF) {
+    while ((opt = getopt_long(argc, argv, "b:t:a:o:m:f:d:e:x:l:c:r:k:?", long_options, NULL)) != EOF) {
         switch (opt) {
         case 'b':
             myCircuitFile = std::string(optarg);
+            myNumRequiredOptions++;
             break;
         case 't':
             MAX_THREADS = atoi(optarg);
+            myNumRequiredOptions++;
             break;
         case 'a':
             MAX_ACTIVE_TASKS = atoi(optarg);
+            myNumRequiredOptions++;
             break;
         case 'o':
             MAX_PARALLEL_OBJECTIVES = atoi(optarg);
+            myNumRequiredOptions++;
             break;
         case 'm':
             PARALLEL_MODE = *optarg;
+            myNumRequiredOptions++;
+            break;
+        case 'f':
+            MAX_FRAMES = atoi(optarg);
+            break;
+        case 'd':
+            DFRONTIER_ORDER = *optarg;
+            break;
+        case 'e':
+            PODEM_HEURISTIC = *optarg;
+            break;
+        case 'x':
+            X_PATH_CHECK = atoi(optarg) != 0;
+            break;
+        case 'l':
+            STATIC_LEARNING = atoi(optarg) != 0;
+            LEARNING_BASELINE = atoi(optarg) == 2;
+            break;
+        case 'c':
+            FAULT_COLLAPSING = atoi(optarg) != 0;
+            break;
+        case 'r':
+            FAULT_DROPPING = atoi(optarg) != 0;
+            break;
+        case 'k':
+            BACKTRACK_LIMIT = atol(optarg);
             break;
         case '?':
         default:
@@ -201,7 +673,7 @@ int main(int argc, char** argv) {
         }
     }
 
-    if (argc != 11) {
+    if (myNumRequiredOptions != 5 || optind != argc) {
         usage(argv[0]);
         return 1;
     }
@@ -215,6 +687,8 @@ int main(int argc, char** argv) {
         std::cout << "Mode: Parallel Across Signals" << std::endl << std::endl;
     } else if (PARALLEL_MODE == 'd' || PARALLEL_MODE == 'D') {
         std::cout << "Mode: Parallel Across Decisions" << std::endl << std::endl;
+    } else if (PARALLEL_MODE == 'f' || PARALLEL_MODE == 'F') {
+        std::cout << "Mode: Parallel Across Faults" << std::endl << std::endl;
     } else {
         std::cout << "Mode: Serial" << std::endl << std::endl;
     }
@@ -226,9 +700,28 @@ int main(int argc, char** argv) {
     // Parse circuit
     std::unique_ptr<Circuit> myCircuit = std::make_unique<Circuit>(myCircuitFile);
 
-    // Run ATPG
-    std::vector<std::tuple<std::pair<std::string, SignalType>, double, std::unordered_map<std::string, SignalType>>> myATPGData;
-    myATPGData = runATPG(*myCircuit);
+    // Run ATPG, on the full-scan core unless asked to unroll the flip-flops
+    const bool mySequentialATPG = MAX_FRAMES > 0 && myCircuit->theTopology->theNumScanCells > 0;
+    std::vector<std::tuple<std::pair<int, SignalType>, double, std::vector<SignalType>>> myATPGData;
+    double myBaselineTime = -1.0;
+    if (mySequentialATPG) {
+        if (STATIC_LEARNING) {
+            std::cout << "Info: Static learning only applies to full-scan ATPG, skipped for the unrolled circuit" << std::endl;
+        }
+        myATPGData = runSequentialATPG(myCircuit->theTopology);
+    } else {
+        myCircuit->setDFrontierOrder(getDFrontierOrder(*myCircuit->theTopology));
+        if (STATIC_LEARNING) {
+            // The baseline search runs without learning first, only its time is kept
+            if (LEARNING_BASELINE) {
+                runATPG(*myCircuit);
+                myBaselineTime = theTotalComputationTime;
+                resetStatistics();
+            }
+            theStaticLearning = std::make_unique<StaticLearning>(myCircuit->theTopology);
+        }
+        myATPGData = runATPG(*myCircuit);
+    }
 
     // Print details
     std::cout << "\n-------------- Total ATPG Computation Time (sec): " << std::fixed << std::setprecision(10) << theTotalComputationTime << " --------------" << std::endl;
@@ -237,16 +730,45 @@ int main(int argc, char** argv) {
     std::cout << "Threads: " << MAX_THREADS << std::endl;
     std::cout << "Max Active Tasks: " << MAX_ACTIVE_TASKS << std::endl;
     std::cout << "Max Parallel Objectives: " << MAX_PARALLEL_OBJECTIVES << std::endl;
+    if (mySequentialATPG) {
+        std::cout << "Max Frames: " << MAX_FRAMES << std::endl;
+    }
+    std::cout << "Heuristic: " << ((PODEM_HEURISTIC == 's' || PODEM_HEURISTIC == 'S') ? "SCOAP" : "First X input") << std::endl;
+    std::cout << "X-Path Check: " << (X_PATH_CHECK ? "on" : "off") << std::endl;
+    if (theStaticLearning) {
+        std::cout << "Static Learning: on | " << theStaticLearning->getNumLearned() << " learned implications | Preprocessing Time (sec): " << theStaticLearning->thePreprocessingTime;
+        if (myBaselineTime >= 0.0) {
+            std::cout << " | Search Time Saved (sec): " << myBaselineTime - theTotalComputationTime << " of " << myBaselineTime;
+        }
+        std::cout << std::endl;
+        std::cout << "Untestable by learning: " << theLearnedUntestableCnt << " | Learning prunes: " << theLearningPruneCnt << " | Implied inputs: " << theImpliedInputCnt << std::endl;
+    } else {
+        std::cout << "Static Learning: off" << std::endl;
+    }
+    if (!mySequentialATPG) {
+        std::cout << "Fault Collapsing: " << (FAULT_COLLAPSING ? "on" : "off") << " | Fault Dropping: " << (FAULT_DROPPING ? "on" : "off") << " | Backtrack Limit: " << BACKTRACK_LIMIT << std::endl;
+        std::cout << "Faults: " << myATPGData.size() << " | Targeted: " << theTargetedFaultCnt << " | Dropped: " << theDroppedFaultCnt << " | Untestable: " << theUntestableFaultCnt << " | Aborted: " << theAbortedFaultCnt << std::endl;
+    }
+    std::size_t myNumDetected = std::ranges::count_if(myATPGData, [](auto& mySSLTestResult) { return !std::get<2>(mySSLTestResult).empty(); });
+    std::cout << "Fault Coverage: " << std::setprecision(2) << (myATPGData.empty() ? 0.0 : 100.0 * myNumDetected / myATPGData.size()) << "% (" << myNumDetected << " / " << myATPGData.size() << ")" << std::setprecision(10) << std::endl;
+    std::cout << "Decisions: " << theDecisionCnt << " | Backtracks: " << theBacktrackCnt << " | X-path prunes: " << theXPathPruneCnt << std::endl;
+    if (PARALLEL_MODE == 'd' || PARALLEL_MODE == 'D') {
+        std::cout << "Steals: " << theStealCnt << " | Decisions after a test was found: " << theWastedDecisionCnt
+                  << " | Mean time to first test (sec): " << (theSolvedSearchCnt > 0 ? theFirstSolutionTime / theSolvedSearchCnt : 0.0)
+                  << " | Mean cancellation latency (sec): " << (theSolvedSearchCnt > 0 ? theCancellationTime / theSolvedSearchCnt : 0.0) << std::endl;
+    }
     if (PARALLEL_MODE == 's' || PARALLEL_MODE == 'S'){
         std::cout << "Mode: Parallel Across Signals" << std::endl << std::endl;
     } else if (PARALLEL_MODE == 'd' || PARALLEL_MODE == 'D') {
         std::cout << "Mode: Parallel Across Decisions" << std::endl << std::endl;
+    } else if (PARALLEL_MODE == 'f' || PARALLEL_MODE == 'F') {
+        std::cout << "Mode: Parallel Across Faults" << std::endl << std::endl;
     } else {
         std::cout << "Mode: Serial" << std::endl << std::endl;
     }
 
     for (auto& mySSLTestResult : myATPGData) {
-        std::cout << std::get<0>(mySSLTestResult).first << "," << (std::get<0>(mySSLTestResult).second == SignalType::D ? '0' : '1') << "," << std::get<1>(mySSLTestResult) << "," << (!std::get<2>(mySSLTestResult).empty()) << std::endl;
+        std::cout << myCircuit->theTopology->theSignalNames[std::get<0>(mySSLTestResult).first] << "," << (std::get<0>(mySSLTestResult).second == SignalType::D ? '0' : '1') << "," << std::get<1>(mySSLTestResult) << "," << (!std::get<2>(mySSLTestResult).empty()) << std::endl;
     }
 
     #ifdef DEBUG
@@ -254,11 +776,14 @@ int main(int argc, char** argv) {
     #endif
 
     // Write statistics to results file
-    std::vector<std::string> myTokenizedCircuitFileName = tokenize_line(myCircuitFile);
+    std::vector<std::string> myTokenizedCircuitFileName = tokenize_file_name(myCircuitFile);
 
     std::string myBenchName = myTokenizedCircuitFileName[myTokenizedCircuitFileName.size()-2];
 
     std::string myOutputFileName = "./results/output_b_" + myBenchName + "_t_" + std::to_string(MAX_THREADS) + "_a_" + std::to_string(MAX_ACTIVE_TASKS) + "_o_" + std::to_string(MAX_PARALLEL_OBJECTIVES) + "_m_" + PARALLEL_MODE;
+    if (mySequentialATPG) {
+        myOutputFileName += "_f_" + std::to_string(MAX_FRAMES);
+    }
     std::ofstream myOutputFile(myOutputFileName);
 
     if (!myOutputFile) {
@@ -268,10 +793,20 @@ int main(int argc, char** argv) {
     myOutputFile << theTotalComputationTime << std::endl;
 
     for (auto& mySSLTestResult : myATPGData) {
-        myOutputFile << std::get<0>(mySSLTestResult).first << "," << (std::get<0>(mySSLTestResult).second == SignalType::D ? '0' : '1') << "," << std::get<1>(mySSLTestResult) << "," << (!std::get<2>(mySSLTestResult).empty()) << std::endl;
+        myOutputFile << myCircuit->theTopology->theSignalNames[std::get<0>(mySSLTestResult).first] << "," << (std::get<0>(mySSLTestResult).second == SignalType::D ? '0' : '1') << "," << std::get<1>(mySSLTestResult) << "," << (!std::get<2>(mySSLTestResult).empty()) << std::endl;
     }
 
     myOutputFile.close();
 
+    // Sequential designs also get their tests as input sequences, full-scan designs as scan load/unload patterns
+    if (mySequentialATPG) {
+        std::string mySequenceFileName = "./results/sequences_b_" + myBenchName + "_t_" + std::to_string(MAX_THREADS) + "_a_" + std::to_string(MAX_ACTIVE_TASKS) + "_o_" + std::to_string(MAX_PARALLEL_OBJECTIVES) + "_m_" + PARALLEL_MODE + "_f_" + std::to_string(MAX_FRAMES);
+        writeTestSequences(*myCircuit->theTopology, myATPGData, mySequenceFileName);
+    } else if (myCircuit->theTopology->theNumScanCells > 0) {
+        std::string myPatternFileName = "./results/patterns_b_" + myBenchName + "_t_" + std::to_string(MAX_THREADS) + "_a_" + std::to_string(MAX_ACTIVE_TASKS) + "_o_" + std::to_string(MAX_PARALLEL_OBJECTIVES) + "_m_" + PARALLEL_MODE;
+        writeScanPatterns(*myCircuit, myATPGData, myPatternFileName);
+        std::cout << "Info: Wrote scan patterns for " << myCircuit->theTopology->theNumScanCells << " scan cells to " << myPatternFileName << std::endl;
+    }
+
     return 0;
 }
@@ -4,56 +4,125 @@
 
 // Helper function to determine success of PODEM
 bool errorAtPO(Circuit& aCircuit){
-    for (auto& myOutput : aCircuit.theCircuitOutputs) {
-        if ((aCircuit.theCircuitState[myOutput] == SignalType::D) || (aCircuit.theCircuitState[myOutput] == SignalType::D_b)){
-            return true;
-        }
+    return aCircuit.errorAtOutput();
+}
+
+
+// Counts a backtrack both overall and for the fault the circuit searches
+static void countBacktrack(Circuit& aCircuit){
+    #pragma omp atomic
+    theBacktrackCnt++;
+    aCircuit.theNumBacktracks++;
+}
+
+
+// Whether the search on a circuit has used up its backtrack limit and gave up on the fault
+bool isAborted(const Circuit& aCircuit){
+    return BACKTRACK_LIMIT > 0 && aCircuit.theNumBacktracks >= BACKTRACK_LIMIT;
+}
+
+
+// Whether the search below the current node can no longer detect the fault, counting the backtrack if so
+// The X-path check cuts the subtree as soon as no error can reach an output, instead of waiting for the D-frontier to empty
+// A necessary assignment of the fault contradicted by the current node prunes it the same way
+bool isDeadEnd(Circuit& aCircuit){
+    if (isAborted(aCircuit)){
+        return true;
+    }
+    if (aCircuit.theDFrontier.empty() && !(aCircuit.getSignalState(aCircuit.theFaultLocation) == SignalType::X)){
+        countBacktrack(aCircuit);
+        return true;
+    }
+    if (aCircuit.hasRequiredConflict()){
+        countBacktrack(aCircuit);
+        #pragma omp atomic
+        theLearningPruneCnt++;
+        return true;
+    }
+    if (X_PATH_CHECK && !aCircuit.hasXPath()){
+        countBacktrack(aCircuit);
+        #pragma omp atomic
+        theXPathPruneCnt++;
+        return true;
     }
     return false;
 }
 
 
 // Determine noncontrolling value of an input gate type
-SignalType getNonControllingValue(std::string aGate){
-    if (aGate == "AND" || aGate == "and" || aGate == "NAND" || aGate == "nand"){
+SignalType getNonControllingValue(GateType aGate){
+    switch (aGate) {
+    case GateType::AND:
+    case GateType::NAND:
         return SignalType::ONE;
-    }
-    if (aGate == "OR" || aGate == "or" || aGate == "NOR" || aGate == "nor"){
+    case GateType::OR:
+    case GateType::NOR:
+    case GateType::XOR:
+    case GateType::XNOR:
         return SignalType::ZERO;
-    }
-    if (aGate == "XOR" || aGate == "xor" || aGate == "XNOR" || aGate == "xnor"){
+    default:
+        std::cout << "Error: Gate type " << getGateTypeString(aGate) << " should not be on the DFrontier" << std::endl;
         return SignalType::ZERO;
     }
-    std::cout << "Error: Gate type " << aGate << " should not be on the DFrontier" << std::endl;
-    return SignalType::ZERO;
+}
+
+
+// SCOAP-guided choice among the X inputs of a gate that should take the given value (-1 if none can)
+// One input at the controlling value settles the gate, so the easiest is taken; otherwise every input is needed,
+// so the hardest is taken first to find a conflict early
+int getScoapInput(Circuit& aCircuit, int aGate, SignalType anInputValue){
+    const CircuitTopology& myTopology = *aCircuit.theTopology;
+    GateType myGateType = aCircuit.getGateType(aGate);
+    bool myIsXOR = (myGateType == GateType::XOR) || (myGateType == GateType::XNOR);
+    bool myIsControlling = ((myGateType == GateType::AND || myGateType == GateType::NAND) && anInputValue == SignalType::ZERO)
+                        || ((myGateType == GateType::OR || myGateType == GateType::NOR) && anInputValue == SignalType::ONE);
+    bool myTakeEasiest = myIsControlling || myIsXOR || aCircuit.getNumFanins(aGate) == 1;
+
+    int myBestInput = -1;
+    int myBestCost = 0;
+    for (int myFaninIdx = 0; myFaninIdx < aCircuit.getNumFanins(aGate); myFaninIdx++) {
+        int myInput = aCircuit.getFanin(aGate, myFaninIdx);
+        if (aCircuit.getSignalState(myInput) != SignalType::X || !aCircuit.isControllable(myInput)) {
+            continue;
+        }
+        int myInputSignal = aCircuit.getFrameSignal(myInput);
+        int myCost = myIsXOR ? std::min(myTopology.theCC0[myInputSignal], myTopology.theCC1[myInputSignal])
+                             : (anInputValue == SignalType::ONE ? myTopology.theCC1[myInputSignal] : myTopology.theCC0[myInputSignal]);
+        if (myBestInput < 0 || (myTakeEasiest ? myCost < myBestCost : myCost > myBestCost)) {
+            myBestInput = myInput;
+            myBestCost = myCost;
+        }
+    }
+    return myBestInput;
 }
 
 
 // Return a set of current available objectives for Across-Signals parallelism
-std::vector<std::pair<std::string, SignalType>> getMultipleObjectives(Circuit& aCircuit){
-    std::vector<std::pair<std::string, SignalType>> myObjectives = std::vector<std::pair<std::string, SignalType>>();
+std::vector<std::pair<int, SignalType>> getMultipleObjectives(Circuit& aCircuit){
+    std::vector<std::pair<int, SignalType>> myObjectives = std::vector<std::pair<int, SignalType>>();
     // Objective is activation
-    if (aCircuit.theCircuitState[aCircuit.theFaultLocation] == SignalType::X){
+    if (aCircuit.getSignalState(aCircuit.theFaultLocation) == SignalType::X){
         SignalType mySAObjective = (aCircuit.theFaultValue == SignalType::D) ? SignalType::ONE : SignalType::ZERO;
-        myObjectives.push_back(std::pair<std::string, SignalType>(aCircuit.theFaultLocation, mySAObjective));
+        myObjectives.push_back(std::pair<int, SignalType>(aCircuit.theFaultLocation, mySAObjective));
         return myObjectives;
     }
     // Objective is propogation
-    for (std::string myDFrontierGate : aCircuit.theDFrontier) {
+    for (int myDFrontierGate : aCircuit.theDFrontier) {
         if (myObjectives.size() >= static_cast<std::size_t>(MAX_PARALLEL_OBJECTIVES)) {
             break;
         }
-        for (auto& myDFrontierGateInput : aCircuit.theCircuit[myDFrontierGate].inputs) {
-            if ((aCircuit.theCircuitState[myDFrontierGateInput] == SignalType::X)) {
+        for (int myFaninIdx = 0; myFaninIdx < aCircuit.getNumFanins(myDFrontierGate); myFaninIdx++) {
+            int myDFrontierGateInput = aCircuit.getFanin(myDFrontierGate, myFaninIdx);
+            if ((aCircuit.getSignalState(myDFrontierGateInput) == SignalType::X) && aCircuit.isControllable(myDFrontierGateInput)) {
                 if (myObjectives.size() >= static_cast<std::size_t>(MAX_PARALLEL_OBJECTIVES)) {
                     break;
                 }
-                myObjectives.push_back(std::pair<std::string, SignalType>(myDFrontierGateInput, getNonControllingValue(aCircuit.theCircuit[myDFrontierGate].gateType)));
+                myObjectives.push_back(std::pair<int, SignalType>(myDFrontierGateInput, getNonControllingValue(aCircuit.getGateType(myDFrontierGate))));
             }
         }
     }
 
-    if (myObjectives.size() == 0){
+    if (myObjectives.size() == 0 && !aCircuit.isUnrolled()){
         std::cout << "Error: Unable to create objective when it should have been possible" << std::endl;
     }
 
@@ -62,43 +131,75 @@ std::vector<std::pair<std::string, SignalType>> getMultipleObjectives(Circuit& a
 
 
 // Return a single available objective from the circuit
-std::pair<std::string, SignalType> getObjective(Circuit& aCircuit){
+std::pair<int, SignalType> getObjective(Circuit& aCircuit){
     // Objective is activation
-    if (aCircuit.theCircuitState[aCircuit.theFaultLocation] == SignalType::X){
+    if (aCircuit.getSignalState(aCircuit.theFaultLocation) == SignalType::X){
         SignalType mySAObjective = (aCircuit.theFaultValue == SignalType::D) ? SignalType::ONE : SignalType::ZERO;
-        return std::pair<std::string, SignalType>(aCircuit.theFaultLocation, mySAObjective);
+        return std::pair<int, SignalType>(aCircuit.theFaultLocation, mySAObjective);
     }
-    // Objective is propogation
-    std::string myDFrontierGate = *(aCircuit.theDFrontier.begin());
-    for (auto& myDFrontierGateInput : aCircuit.theCircuit[myDFrontierGate].inputs) {
-        if (aCircuit.theCircuitState[myDFrontierGateInput] == SignalType::X){
-            return std::pair<std::string, SignalType>(myDFrontierGateInput, getNonControllingValue(aCircuit.theCircuit[myDFrontierGate].gateType));
+    // Objective is propogation, through the first D-frontier gate in the frontier's order
+    // Unrolled frames may have D-frontier gates whose remaining inputs only depend on the unknown initial state
+    for (int myDFrontierGate : aCircuit.theDFrontier) {
+        if (PODEM_HEURISTIC == 's' || PODEM_HEURISTIC == 'S') {
+            SignalType myNonControllingValue = getNonControllingValue(aCircuit.getGateType(myDFrontierGate));
+            int myDFrontierGateInput = getScoapInput(aCircuit, myDFrontierGate, myNonControllingValue);
+            if (myDFrontierGateInput >= 0) {
+                return std::pair<int, SignalType>(myDFrontierGateInput, myNonControllingValue);
+            }
+        }
+        for (int myFaninIdx = 0; myFaninIdx < aCircuit.getNumFanins(myDFrontierGate); myFaninIdx++) {
+            int myDFrontierGateInput = aCircuit.getFanin(myDFrontierGate, myFaninIdx);
+            if (aCircuit.getSignalState(myDFrontierGateInput) == SignalType::X && aCircuit.isControllable(myDFrontierGateInput)){
+                return std::pair<int, SignalType>(myDFrontierGateInput, getNonControllingValue(aCircuit.getGateType(myDFrontierGate)));
+            }
         }
+        if (!aCircuit.isUnrolled()) {
+            break;
+        }
+    }
+    if (!aCircuit.isUnrolled()) {
+        std::cout << "Error: Unable to create objective when it should have been possible" << std::endl;
     }
-    std::cout << "Error: Unable to create objective when it should have been possible" << std::endl;
-    return std::pair<std::string, SignalType>("", SignalType::X);
+    return std::pair<int, SignalType>(-1, SignalType::X);
 }
 
 
 // Given an objective, backtrace to a primary input to determine signal input and value based on circuit heuristics
-std::pair<std::string, SignalType> doBacktrace(Circuit& aCircuit, std::pair<std::string, SignalType> anObjective){
-    std::string myBacktraceSignal = anObjective.first;
+// Returns signal -1 if the objective cannot be justified from the decision inputs (unknown initial state of an unrolled circuit)
+std::pair<int, SignalType> doBacktrace(Circuit& aCircuit, std::pair<int, SignalType> anObjective){
+    int myBacktraceSignal = anObjective.first;
     SignalType myBacktraceValue = anObjective.second;
 
-    while (std::ranges::find(aCircuit.theCircuitInputs, myBacktraceSignal) == aCircuit.theCircuitInputs.end()){
-        Gate myGate = aCircuit.theCircuit[myBacktraceSignal];
-        bool myGateBubble = (myGate.gateType == "NAND") || (myGate.gateType == "nand") || (myGate.gateType == "NOR") || (myGate.gateType == "nor") || (myGate.gateType == "XNOR") || (myGate.gateType == "xnor") || (myGate.gateType == "NOT") || (myGate.gateType == "not");
+    if (myBacktraceSignal < 0 || !aCircuit.isControllable(myBacktraceSignal)) {
+        return std::pair<int, SignalType>(-1, SignalType::X);
+    }
+
+    // Present-state inputs of an unrolled frame are traced through into the previous frame
+    while (!aCircuit.isDecisionInput(myBacktraceSignal)){
+        GateType myGateType = aCircuit.getGateType(myBacktraceSignal);
+        bool myGateBubble = (myGateType == GateType::NAND) || (myGateType == GateType::NOR) || (myGateType == GateType::XNOR) || (myGateType == GateType::NOT);
 
-        std::string myBacktraceSignalPrev = myBacktraceSignal; // DEBUG code
-        for (auto& myBacktraceGateInput : aCircuit.theCircuit[myBacktraceSignal].inputs){
-            if (aCircuit.theCircuitState[myBacktraceGateInput] == SignalType::X){
-                myBacktraceSignal = myBacktraceGateInput;
-                break;
+        int myBacktraceSignalPrev = myBacktraceSignal; // DEBUG code
+        if (PODEM_HEURISTIC == 's' || PODEM_HEURISTIC == 'S') {
+            SignalType myInputValue = myGateBubble ? ((myBacktraceValue == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE) : myBacktraceValue;
+            int myBacktraceGateInput = getScoapInput(aCircuit, myBacktraceSignal, myInputValue);
+            myBacktraceSignal = (myBacktraceGateInput >= 0) ? myBacktraceGateInput : myBacktraceSignal;
+        } else {
+            for (int myFaninIdx = 0; myFaninIdx < aCircuit.getNumFanins(myBacktraceSignal); myFaninIdx++){
+                int myBacktraceGateInput = aCircuit.getFanin(myBacktraceSignal, myFaninIdx);
+                if (aCircuit.getSignalState(myBacktraceGateInput) == SignalType::X && aCircuit.isControllable(myBacktraceGateInput)){
+                    myBacktraceSignal = myBacktraceGateInput;
+                    break;
+                }
             }
         }
 
+        // Expected when unrolled - the only X inputs left may hang off the unknown initial state
         if (myBacktraceSignal == myBacktraceSignalPrev){ // DEBUG code
-            std::cout << "Error: unable to perform backtrace (find input value == X)" << std::endl;
+            if (!aCircuit.isUnrolled()) {
+                std::cout << "Error: unable to perform backtrace (find input value == X)" << std::endl;
+            }
+            return std::pair<int, SignalType>(-1, SignalType::X);
         }
 
         if (myGateBubble){
@@ -106,283 +207,355 @@ std::pair<std::string, SignalType> doBacktrace(Circuit& aCircuit, std::pair<std:
         }
     }
 
-    return std::pair<std::string, SignalType>(myBacktraceSignal, myBacktraceValue);
+    return std::pair<int, SignalType>(myBacktraceSignal, myBacktraceValue);
 }
 
 
-// PODEM with tasks parallelized Across-Decisions
-std::unordered_map<std::string, SignalType> runPODEMRecursiveParallelDecisions(Circuit& aCircuit){
+// Per-thread circuits used by the parallel modes
+// A task only carries its decision path; the executing thread syncs its own circuit to that path through the trail
+std::vector<Circuit> theWorkerCircuits;
 
-    // aCircuit.printCircuitState();
-    if (theSolutionFound) {
-        return std::unordered_map<std::string, SignalType>();
-    }
 
-    if (errorAtPO(aCircuit)){
-        theSolutionFound = true;
-        return aCircuit.getCurrCircuitInputValues();
+// Gives each thread its own search state over the shared topology, then targets it at the current fault
+// Workers are copies of the given circuit, so they share its frame count and D-frontier order
+void prepareWorkerCircuits(Circuit& aCircuit){
+    std::size_t myNumWorkers = omp_get_max_threads();
+    if (theWorkerCircuits.size() != myNumWorkers || theWorkerCircuits[0].theTopology != aCircuit.theTopology
+        || theWorkerCircuits[0].getNumFrames() != aCircuit.getNumFrames() || theWorkerCircuits[0].isUnrolled() != aCircuit.isUnrolled()
+        || theWorkerCircuits[0].theDFrontier.getOrder() != aCircuit.theDFrontier.getOrder()) {
+        theWorkerCircuits = std::vector<Circuit>(myNumWorkers, aCircuit);
+        #ifdef DEBUG
+        std::cout << "Debug: " << myNumWorkers << " worker circuits, " << theWorkerCircuits[0].getStateSizeInBytes() << " bytes of search state each" << std::endl;
+        #endif
     }
-    if (aCircuit.theDFrontier.empty() && !(aCircuit.theCircuitState[aCircuit.theFaultLocation] == SignalType::X)){
-        return std::unordered_map<std::string, SignalType>();
+    for (auto& myWorkerCircuit : theWorkerCircuits) {
+        myWorkerCircuit.setCancellation(nullptr, 0);
+        myWorkerCircuit.setCircuitFault(aCircuit.theFaultLocation, aCircuit.theFaultValue);
+        myWorkerCircuit.setRequiredValues(aCircuit.getRequiredValues());
+        myWorkerCircuit.resetCircuit();
     }
+}
 
-    // Find an objective within the circuit
-    std::pair<std::string, SignalType> myObjective = getObjective(aCircuit);
 
-    // std:: cout << "Info: My current objective: " << myObjective.first << " | " << myObjective.second << std::endl;
+// Whether a worker of the last parallel search gave up on the fault
+bool isWorkerSearchAborted(){
+    return std::ranges::any_of(theWorkerCircuits, [](const Circuit& aWorkerCircuit) { return isAborted(aWorkerCircuit); });
+}
 
-    // Backtrce to primary input to make a decision
-    std::pair<std::string, SignalType> myDecision = doBacktrace(aCircuit, myObjective);
 
-    // std:: cout << "Info: My current decision: " << myDecision.first << " | " << myDecision.second << std::endl;
+// Returns the calling thread's circuit, moved to the given search node
+Circuit& getWorkerCircuit(const std::vector<std::pair<int, SignalType>>& aDecisions){
+    Circuit& myCircuit = theWorkerCircuits[omp_get_thread_num()];
+    myCircuit.syncDecisions(aDecisions);
+    return myCircuit;
+}
 
-    const int myNumTasks = 2;
-    std::unordered_map<std::string, SignalType> myPODEMResults[myNumTasks];
-    std::vector<Circuit> myCircuits = std::vector<Circuit>(myNumTasks);
 
-    // std::cout << "Number of active tasks: " << theTaskCnt << std::endl;
+// Open node of the decision tree - the decision path leading to it, tagged with the epoch of the fault's search
+struct SearchNode {
+    unsigned epoch;
+    std::vector<std::pair<int, SignalType>> decisions;
+};
 
-    // Under the parallel-throttling threshold, spawn new tasks
-    if (theTaskCnt < MAX_ACTIVE_TASKS){
 
-        // Update number of active tasks
-        #pragma omp critical
-        {
-            theTaskCnt += 2;
-            if (theTaskCnt > theMaxTaskCnt) {
-                theMaxTaskCnt = theTaskCnt;
+// Nodes of one worker - the owner pushes and pops at the back (depth first, in serial PODEM order),
+// thieves take from the front where the shallowest and so largest open subtrees sit
+struct WorkerDeque {
+    std::mutex lock;
+    std::deque<SearchNode> nodes;
+};
+
+std::vector<WorkerDeque> theWorkerDeques;
+
+// Epoch of the current decision-parallel search, one per fault
+unsigned theSearchEpoch = 0;
+
+// Cancellation token - the epoch of the last search that found a test, which stops every worker still searching in it
+std::atomic<unsigned> theSolvedEpoch = 0;
+
+// Nodes pushed but not yet fully explored, the search is exhausted once this drops to zero
+std::atomic<long> theOpenNodeCnt = 0;
+
+
+// Take a node of the current search, from the worker's own deque first and otherwise stolen from the others
+// Returns false once the search is cancelled or no node is left anywhere
+static bool takeSearchNode(int aWorker, unsigned anEpoch, SearchNode& aNode){
+    const int myNumWorkers = theWorkerDeques.size();
+    while (theSolvedEpoch.load(std::memory_order_relaxed) != anEpoch) {
+        for (int myOffset = 0; myOffset < myNumWorkers; myOffset++) {
+            WorkerDeque& myDeque = theWorkerDeques[(aWorker + myOffset) % myNumWorkers];
+            std::lock_guard<std::mutex> myLock(myDeque.lock);
+            if (myDeque.nodes.empty()) {
+                continue;
+            }
+            if (myOffset == 0) {
+                aNode = std::move(myDeque.nodes.back());
+                myDeque.nodes.pop_back();
+            } else {
+                aNode = std::move(myDeque.nodes.front());
+                myDeque.nodes.pop_front();
+                #pragma omp atomic
+                theStealCnt++;
             }
+            return true;
+        }
+        if (theOpenNodeCnt.load() == 0) {
+            return false;
         }
+        std::this_thread::yield();
+    }
+    return false;
+}
 
-        // Spawn concurrent tasks for the decisions
-        #pragma taskgroup
-        {
-            // std::cout << "Spawning tasks from thread " << omp_get_thread_num() << std::endl;
-            #pragma omp task untied shared(myCircuits) shared(myPODEMResults)
-            {
-                // std::cout << "Executing task 0 in thread " << omp_get_thread_num() << " at nested level " << omp_get_level() << std::endl;
-                myCircuits[0] = aCircuit;
-                myCircuits[0].setAndImplyCircuitInput(myDecision.first, myDecision.second);
-                myPODEMResults[0] = runPODEMRecursiveParallelDecisions(myCircuits[0]);
-                // finishedTasks0 = true;
-                #pragma omp critical
-                {
-                    theTaskCnt--;
-                }
-            }
 
-            #pragma omp task untied shared(myCircuits) shared(myPODEMResults)
-            {
-                // std::cout << "Executing task 1 in thread " << omp_get_thread_num() << " at nested level " << omp_get_level() << std::endl;
-                myCircuits[1] = aCircuit;
-                myCircuits[1].setAndImplyCircuitInput(myDecision.first, (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE);
-                myPODEMResults[1] = runPODEMRecursiveParallelDecisions(myCircuits[1]);
-                // finishedTasks1 = true;
-                #pragma omp critical
-                {
-                    theTaskCnt--;
-                }
+// Depth-first search below a node on the worker's own circuit, until it dead-ends or the search is cancelled
+// The opposite value of every decision is left on the worker's deque rather than recursed into, so the deque is the
+// backtrack stack and whatever an idle worker steals is an untried alternative
+static void exploreSearchNode(Circuit& aCircuit, int aWorker, const SearchNode& aNode, std::vector<SignalType>& aTestVector, std::chrono::steady_clock::time_point aStartTime, double& aSolutionTime){
+    aCircuit.syncDecisions(aNode.decisions);
+    while (true) {
+        // Checked first, a cancelled implication leaves the circuit half implied
+        if (aCircuit.isCancelled()) {
+            return;
+        }
+        if (errorAtPO(aCircuit)){
+            // Only the first worker to find a test in this epoch reports it
+            if (theSolvedEpoch.exchange(aNode.epoch) != aNode.epoch) {
+                aSolutionTime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - aStartTime).count();
+                aTestVector = aCircuit.getCurrCircuitInputValues();
             }
-            // std::cout << "Thread waiting at taskwait " << omp_get_thread_num() << std::endl;
-            #pragma omp taskwait
+            return;
         }
-        // }
-        // std::cout << "Thread proceeding after taskwait " << omp_get_thread_num() << std::endl;
-
-        // while (!finishedTasks0 || !finishedTasks1) {
-        //     #pragma omp taskyield
-        // }
-
-        // Check results of each decision
-        if (!myPODEMResults[0].empty()) {
-            aCircuit = myCircuits[0];
-            return myPODEMResults[0];
-        } else if (!myPODEMResults[1].empty()) {
-            aCircuit = myCircuits[1];
-            return myPODEMResults[1];
-        } else {
-            aCircuit.setAndImplyCircuitInput(myDecision.first, SignalType::X);
-            return std::unordered_map<std::string, SignalType>();
+        if (isDeadEnd(aCircuit)){
+            return;
         }
 
-    // Default to serial computation
-    } else {
+        std::pair<int, SignalType> myDecision = doBacktrace(aCircuit, getObjective(aCircuit));
+        if (myDecision.first < 0){
+            countBacktrack(aCircuit);
+            return;
+        }
+        #pragma omp atomic
+        theDecisionCnt++;
 
-        // Set decision and recursively run PODEM
-        aCircuit.setAndImplyCircuitInput(myDecision.first, myDecision.second);
-        std::unordered_map<std::string, SignalType> myPODEMResult = runPODEMRecursiveParallelDecisions(aCircuit);
-        if(!myPODEMResult.empty()){
-            return myPODEMResult;
+        // Counted open before it is visible, so no thief can see the search exhausted while it is being pushed
+        SearchNode myAlternative = {aNode.epoch, aCircuit.theDecisions};
+        myAlternative.decisions.push_back(std::pair<int, SignalType>(myDecision.first, (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE));
+        theOpenNodeCnt++;
+        {
+            std::lock_guard<std::mutex> myLock(theWorkerDeques[aWorker].lock);
+            theWorkerDeques[aWorker].nodes.push_back(std::move(myAlternative));
         }
 
-        // Previous decision failed, backtrack and try opposite decision
-        myDecision.second = (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE;
-        aCircuit.setAndImplyCircuitInput(myDecision.first, myDecision.second);
-        myPODEMResult = runPODEMRecursiveParallelDecisions(aCircuit);
-        if(!myPODEMResult.empty()){
-            return myPODEMResult;
+        aCircuit.pushDecision(myDecision.first, myDecision.second);
+
+        // Implication that another worker's test made useless
+        if (aCircuit.isCancelled()) {
+            #pragma omp atomic
+            theWastedDecisionCnt++;
         }
+    }
+}
+
 
-        // Failed, reset decision and return NULL
-        aCircuit.setAndImplyCircuitInput(myDecision.first, SignalType::X);
-        return std::unordered_map<std::string, SignalType>();
+// PODEM parallelized Across-Decisions on a work-stealing scheduler, over the circuits set up by prepareWorkerCircuits
+// The first test found cancels the search: workers stop taking nodes and their implications stop between levels
+// The search starts from the given root decisions, which are never backtracked
+std::vector<SignalType> runPODEMWorkStealing(const std::vector<std::pair<int, SignalType>>& aRootDecisions){
+    const auto myStartTime = std::chrono::steady_clock::now();
+    const unsigned myEpoch = ++theSearchEpoch;
 
+    // Nodes left behind by the previous fault's cancelled search are dropped
+    if (theWorkerDeques.size() != theWorkerCircuits.size()) {
+        theWorkerDeques = std::vector<WorkerDeque>(theWorkerCircuits.size());
     }
+    for (auto& myDeque : theWorkerDeques) {
+        myDeque.nodes.clear();
+    }
+    theWorkerDeques[0].nodes.push_back(SearchNode{myEpoch, aRootDecisions});
+    theOpenNodeCnt = 1;
+
+    std::vector<SignalType> myTestVector;
+    double mySolutionTime = -1.0;
+    #pragma omp parallel
+    {
+        const int myWorker = omp_get_thread_num();
+        Circuit& myCircuit = theWorkerCircuits[myWorker];
+        myCircuit.setCancellation(&theSolvedEpoch, myEpoch);
+
+        SearchNode myNode;
+        while (takeSearchNode(myWorker, myEpoch, myNode)) {
+            exploreSearchNode(myCircuit, myWorker, myNode, myTestVector, myStartTime, mySolutionTime);
+            theOpenNodeCnt--;
+        }
+    }
+
+    // Time to first solution, and how long the remaining workers took to notice the cancellation
+    if (mySolutionTime >= 0.0) {
+        theSolvedSearchCnt++;
+        theFirstSolutionTime += mySolutionTime;
+        theCancellationTime += std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - myStartTime).count() - mySolutionTime;
+    }
+
+    return myTestVector;
 }
 
 
 // Serial implementation of the PODEM algorithm
-std::unordered_map<std::string, SignalType> runPODEMRecursiveSerial(Circuit& aCircuit){
+std::vector<SignalType> runPODEMRecursiveSerial(Circuit& aCircuit){
 
     // aCircuit.printCircuitState();
+    // Only the parallel searches share a solution flag, serial searches may run on several faults at once
     if (errorAtPO(aCircuit)){
-        theSolutionFound = true;
         return aCircuit.getCurrCircuitInputValues();
     }
-    if (aCircuit.theDFrontier.empty() && !(aCircuit.theCircuitState[aCircuit.theFaultLocation] == SignalType::X)){
-        return std::unordered_map<std::string, SignalType>();
+    if (isDeadEnd(aCircuit)){
+        return std::vector<SignalType>();
     }
 
     // Backtrce to primary input to make a decision
-    std::pair<std::string, SignalType> myObjective = getObjective(aCircuit);
+    std::pair<int, SignalType> myObjective = getObjective(aCircuit);
 
     // std:: cout << "Info: My current objective: " << myObjective.first << " | " << myObjective.second << std::endl;
 
     // Backtrce to primary input to make a decision
-    std::pair<std::string, SignalType> myDecision = doBacktrace(aCircuit, myObjective);
+    std::pair<int, SignalType> myDecision = doBacktrace(aCircuit, myObjective);
+    if (myDecision.first < 0){
+        countBacktrack(aCircuit);
+        return std::vector<SignalType>();
+    }
+    #pragma omp atomic
+    theDecisionCnt++;
 
     // std:: cout << "Info: My current decision: " << myDecision.first << " | " << myDecision.second << std::endl;
 
     // Set decision and recursively run PODEM
-    aCircuit.setAndImplyCircuitInput(myDecision.first, myDecision.second);
-    std::unordered_map<std::string, SignalType> myPODEMResult = runPODEMRecursiveSerial(aCircuit);
+    aCircuit.pushDecision(myDecision.first, myDecision.second);
+    std::vector<SignalType> myPODEMResult = runPODEMRecursiveSerial(aCircuit);
     if(!myPODEMResult.empty()){
         return myPODEMResult;
     }
 
-    // Previous decision failed, backtrack and try opposite decision
+    // Previous decision failed, roll back through the trail and try opposite decision
+    aCircuit.popDecision();
     myDecision.second = (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE;
-    aCircuit.setAndImplyCircuitInput(myDecision.first, myDecision.second);
+    aCircuit.pushDecision(myDecision.first, myDecision.second);
     myPODEMResult = runPODEMRecursiveSerial(aCircuit);
     if(!myPODEMResult.empty()){
         return myPODEMResult;
     }
 
-    // Failed, reset decision and return NULL
-    aCircuit.setAndImplyCircuitInput(myDecision.first, SignalType::X);
-    return std::unordered_map<std::string, SignalType>();
+    // Failed, undo decision and return NULL
+    aCircuit.popDecision();
+    return std::vector<SignalType>();
 }
 
 
 // PODEM with tasks parallelized Across-Signals
-std::unordered_map<std::string, SignalType> runPODEMRecursiveParallelSignals(Circuit& aCircuit){
+std::vector<SignalType> runPODEMRecursiveParallelSignals(std::vector<std::pair<int, SignalType>>& aDecisions){
 
-    // aCircuit.printCircuitState();
     if (theSolutionFound) {
-        return std::unordered_map<std::string, SignalType>();
+        return std::vector<SignalType>();
     }
 
+    Circuit& aCircuit = getWorkerCircuit(aDecisions);
+
+    // aCircuit.printCircuitState();
     if (errorAtPO(aCircuit)){
         theSolutionFound = true;
         return aCircuit.getCurrCircuitInputValues();
     }
-    if (aCircuit.theDFrontier.empty() && !(aCircuit.theCircuitState[aCircuit.theFaultLocation] == SignalType::X)){
-        return std::unordered_map<std::string, SignalType>();
+    if (isDeadEnd(aCircuit)){
+        return std::vector<SignalType>();
     }
 
     // Generate a set of concurrent objectives
-    std::vector<std::pair<std::string, SignalType>> myObjectives = getMultipleObjectives(aCircuit);
-    int myObjectivesSize = myObjectives.size();
-
-    // std:: cout << "Info: My current objective: " << myObjective.first << " | " << myObjective.second << std::endl;
+    std::vector<std::pair<int, SignalType>> myObjectives = getMultipleObjectives(aCircuit);
+
+    // Make a custom decision for each objective while this thread's circuit is at the current node
+    std::vector<std::pair<int, SignalType>> myDecisions = std::vector<std::pair<int, SignalType>>();
+    for (auto& myObjective : myObjectives) {
+        std::pair<int, SignalType> myDecision = doBacktrace(aCircuit, myObjective);
+        if (myDecision.first >= 0) {
+            myDecisions.push_back(myDecision);
+        }
+    }
+    if (myDecisions.empty()){
+        countBacktrack(aCircuit);
+        return std::vector<SignalType>();
+    }
+    #pragma omp atomic
+    theDecisionCnt++;
+    int myObjectivesSize = myDecisions.size();
 
     // std:: cout << "Info: My current decision: " << myDecision.first << " | " << myDecision.second << std::endl;
 
-
     const int myNumTasks = MAX_PARALLEL_OBJECTIVES;
-    std::unordered_map<std::string, SignalType> myPODEMResults[myNumTasks];
-    std::vector<Circuit> myCircuits = std::vector<Circuit>(myNumTasks);
+    std::vector<SignalType> myPODEMResults[myNumTasks];
 
     // std::cout << "Number of active tasks: " << theTaskCnt << std::endl;
 
-    if (theTaskCnt < MAX_ACTIVE_TASKS){
+    if (theTaskCnt.load() < MAX_ACTIVE_TASKS){
 
+        int myTaskCnt = (theTaskCnt += myObjectivesSize);
         #pragma omp critical
         {
-            theTaskCnt += myObjectives.size();
-            if (theTaskCnt > theMaxTaskCnt) {
-                theMaxTaskCnt = theTaskCnt;
+            if (myTaskCnt > theMaxTaskCnt) {
+                theMaxTaskCnt = myTaskCnt;
             }
         }
 
-        #pragma taskgroup
+        #pragma omp taskgroup
         {
             // std::cout << "Spawning tasks from thread " << omp_get_thread_num() << std::endl;
             for (int i = 0; i < myObjectivesSize; i++) {
-                std::pair<std::string, SignalType> myObjective = myObjectives[i];
 
                 // Spawn a task for each possible propogation strategy
-                #pragma omp task untied shared(myCircuits) shared(myPODEMResults)
+                #pragma omp task untied shared(aDecisions) shared(myDecisions) shared(myPODEMResults)
                 {
-                    // Make a custom decision for each objective
-                    std::pair<std::string, SignalType> myDecision = doBacktrace(aCircuit, myObjective);
-
-                    myCircuits[i] = aCircuit;
-                    myCircuits[i].setAndImplyCircuitInput(myDecision.first, myDecision.second);
-                    myPODEMResults[i] = runPODEMRecursiveParallelSignals(myCircuits[i]);
+                    std::vector<std::pair<int, SignalType>> myTaskDecisions = aDecisions;
+                    myTaskDecisions.push_back(myDecisions[i]);
+                    myPODEMResults[i] = runPODEMRecursiveParallelSignals(myTaskDecisions);
 
                     if(myPODEMResults[i].empty()){
-                        myDecision.second = (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE;
-                        myCircuits[i].setAndImplyCircuitInput(myDecision.first, myDecision.second);
-                        myPODEMResults[i] = runPODEMRecursiveParallelSignals(myCircuits[i]);
+                        myTaskDecisions.back().second = (myDecisions[i].second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE;
+                        myPODEMResults[i] = runPODEMRecursiveParallelSignals(myTaskDecisions);
                     }
 
-                    #pragma omp critical
-                    {
-                        theTaskCnt--;
-                    }
+                    theTaskCnt--;
                 }
             }
             // std::cout << "Thread waiting at taskwait " << omp_get_thread_num() << std::endl;
             #pragma omp taskwait
         }
-        // }
         // std::cout << "Thread proceeding after taskwait " << omp_get_thread_num() << std::endl;
 
-        // while (!finishedTasks0 || !finishedTasks1) {
-        //     #pragma omp taskyield
-        // }
-
         for (int i = 0; i < myObjectivesSize; i++) {
             if (!myPODEMResults[i].empty()) {
-                aCircuit = myCircuits[i];
                 return myPODEMResults[i];
             }
         }
 
-        return std::unordered_map<std::string, SignalType>();
+        return std::vector<SignalType>();
 
     } else {
-        std::pair<std::string, SignalType> myDecision = doBacktrace(aCircuit, myObjectives[0]);
+        std::pair<int, SignalType> myDecision = myDecisions[0];
 
         // Set decision and recursively run PODEM
-        aCircuit.setAndImplyCircuitInput(myDecision.first, myDecision.second);
-        std::unordered_map<std::string, SignalType> myPODEMResult = runPODEMRecursiveParallelSignals(aCircuit);
+        aDecisions.push_back(myDecision);
+        std::vector<SignalType> myPODEMResult = runPODEMRecursiveParallelSignals(aDecisions);
         if(!myPODEMResult.empty()){
+            aDecisions.pop_back();
             return myPODEMResult;
         }
 
         // Previous decision failed, backtrack and try opposite decision
-        myDecision.second = (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE;
-        aCircuit.setAndImplyCircuitInput(myDecision.first, myDecision.second);
-        myPODEMResult = runPODEMRecursiveParallelSignals(aCircuit);
-        if(!myPODEMResult.empty()){
-            return myPODEMResult;
-        }
+        aDecisions.back().second = (myDecision.second == SignalType::ONE) ? SignalType::ZERO : SignalType::ONE;
+        myPODEMResult = runPODEMRecursiveParallelSignals(aDecisions);
 
-        // Failed, reset decision and return NULL
-        aCircuit.setAndImplyCircuitInput(myDecision.first, SignalType::X);
-        return std::unordered_map<std::string, SignalType>();
+        // Return the result (empty on failure) with the decision undone
+        aDecisions.pop_back();
+        return myPODEMResult;
 
     }
 }
@@ -9,6 +9,9 @@
 #include <string>
 #include <vector>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
 
 #include <unistd.h>
 #include <omp.h>
@@ -16,12 +19,31 @@
 
 extern int MAX_PARALLEL_OBJECTIVES;
 extern int MAX_ACTIVE_TASKS;
+extern char PODEM_HEURISTIC;
 
-extern int theTaskCnt;
+extern std::atomic<int> theTaskCnt;
 extern int theMaxTaskCnt;
 
-extern bool theSolutionFound;
+extern std::atomic<bool> theSolutionFound;
 
-std::unordered_map<std::string, SignalType> runPODEMRecursiveParallelSignals(Circuit& aCircuit);
-std::unordered_map<std::string, SignalType> runPODEMRecursiveParallelDecisions(Circuit& aCircuit);
-std::unordered_map<std::string, SignalType> runPODEMRecursiveSerial(Circuit& aCircuit);
+// Work-stealing statistics of decision-parallel searches, summed over all faults
+extern long theStealCnt;
+extern long theWastedDecisionCnt;
+extern int theSolvedSearchCnt;
+extern double theFirstSolutionTime;
+extern double theCancellationTime;
+
+extern bool X_PATH_CHECK;
+extern long BACKTRACK_LIMIT;
+extern long theBacktrackCnt;
+extern long theXPathPruneCnt;
+extern long theLearningPruneCnt;
+extern long theDecisionCnt;
+
+void prepareWorkerCircuits(Circuit& aCircuit);
+bool isAborted(const Circuit& aCircuit);
+bool isWorkerSearchAborted();
+
+std::vector<SignalType> runPODEMRecursiveParallelSignals(std::vector<std::pair<int, SignalType>>& aDecisions);
+std::vector<SignalType> runPODEMWorkStealing(const std::vector<std::pair<int, SignalType>>& aRootDecisions);
+std::vector<SignalType> runPODEMRecursiveSerial(Circuit& aCircuit);